@@ -0,0 +1,333 @@
+#include "data_generator.h"
+#include "ilona.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Набір бенчмарків: ilona_bench [кількість_рядків ...] [--runs N] [--seed N]
+// Для кожного розміру генерує детермінований набір даних і вимірює пропускну
+// здатність та затримки p50/p99 основних операцій.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t OPERATION_BATCH_SIZE = 1024;
+
+// Результати звітів записуються сюди, щоб компілятор не викинув виклики.
+volatile std::size_t resultSink = 0;
+
+double elapsedNs(const Clock::time_point start, const Clock::time_point end) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+struct BenchmarkResult {
+    std::string operation;
+    std::size_t rows;
+    std::vector<double> samplesNs;
+    double throughput;
+};
+
+double percentile(std::vector<double> samples, const double fraction) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    const std::size_t rank = static_cast<std::size_t>(std::ceil(fraction * samples.size()));
+    return samples[std::max<std::size_t>(rank, 1) - 1];
+}
+
+std::string formatDuration(const double ns) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+    if (ns < 1e3) {
+        out << ns << " нс";
+    } else if (ns < 1e6) {
+        out << ns / 1e3 << " мкс";
+    } else if (ns < 1e9) {
+        out << ns / 1e6 << " мс";
+    } else {
+        out << ns / 1e9 << " с";
+    }
+    return out.str();
+}
+
+// std::setw рахує байти, а не символи, тому кирилиця зсуває колонки.
+std::string padColumn(const std::string& text, const std::size_t width, const bool alignLeft) {
+    std::size_t characters = 0;
+    for (const char c : text) {
+        if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) {
+            ++characters;
+        }
+    }
+    const std::string padding(width > characters ? width - characters : 0, ' ');
+    return alignLeft ? text + padding : padding + text;
+}
+
+void printRow(const std::string& operation, const std::string& rows, const std::string& samples,
+              const std::string& throughput, const std::string& p50, const std::string& p99) {
+    std::cout << padColumn(operation, 44, true) << padColumn(rows, 10, false) << padColumn(samples, 9, false)
+              << padColumn(throughput, 14, false) << padColumn(p50, 14, false) << padColumn(p99, 14, false)
+              << std::endl;
+}
+
+void printResult(const BenchmarkResult& result) {
+    printRow(result.operation, std::to_string(result.rows), std::to_string(result.samplesNs.size()),
+             std::to_string(static_cast<long long>(result.throughput)),
+             formatDuration(percentile(result.samplesNs, 0.50)), formatDuration(percentile(result.samplesNs, 0.99)));
+}
+
+// Повторює операцію над усією чергою; кожен повтор - один вимір.
+template <typename Fn>
+BenchmarkResult measureWholeQueue(const std::string& operation, const std::size_t rows, const int runs, Fn&& fn) {
+    BenchmarkResult result{ operation, rows, {}, 0.0 };
+    for (int run = 0; run < runs; ++run) {
+        const Clock::time_point start = Clock::now();
+        fn(run);
+        result.samplesNs.push_back(elapsedNs(start, Clock::now()));
+    }
+    const double medianSeconds = percentile(result.samplesNs, 0.50) / 1e9;
+    result.throughput = medianSeconds > 0.0 ? rows / medianSeconds : 0.0;
+    return result;
+}
+
+// Як measureWholeQueue, але перед кожним повтором виконує setup поза виміром -
+// для операцій, що руйнують дані, на яких їх вимірюють.
+template <typename Setup, typename Fn>
+BenchmarkResult measureWithSetup(const std::string& operation, const std::size_t rows, const int runs,
+                                 Setup&& setup, Fn&& fn) {
+    BenchmarkResult result{ operation, rows, {}, 0.0 };
+    for (int run = 0; run < runs; ++run) {
+        setup(run);
+        const Clock::time_point start = Clock::now();
+        fn(run);
+        result.samplesNs.push_back(elapsedNs(start, Clock::now()));
+    }
+    const double medianSeconds = percentile(result.samplesNs, 0.50) / 1e9;
+    result.throughput = medianSeconds > 0.0 ? rows / medianSeconds : 0.0;
+    return result;
+}
+
+// Для дешевих операцій: кожен вимір - середній час одного виклику в пакеті з
+// OPERATION_BATCH_SIZE викликів; пропускна здатність - викликів за секунду.
+template <typename Fn>
+BenchmarkResult measurePerCall(const std::string& operation, const std::size_t rows, const int runs, Fn&& fn) {
+    BenchmarkResult result{ operation, rows, {}, 0.0 };
+    const Clock::time_point totalStart = Clock::now();
+    for (int run = 0; run < runs; ++run) {
+        const Clock::time_point start = Clock::now();
+        for (std::size_t call = 0; call < OPERATION_BATCH_SIZE; ++call) {
+            fn();
+        }
+        result.samplesNs.push_back(elapsedNs(start, Clock::now()) / OPERATION_BATCH_SIZE);
+    }
+    result.throughput = runs * OPERATION_BATCH_SIZE / (elapsedNs(totalStart, Clock::now()) / 1e9);
+    return result;
+}
+
+std::vector<BenchmarkResult> runSuite(const std::size_t rows, const int runs, const std::uint64_t seed) {
+    std::vector<BenchmarkResult> results;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::string textFile = (directory / "ilona_bench.txt").string();
+    const std::string compressedFile = (directory / "ilona_bench.iwz").string();
+
+    WasteDataGenerator generator(seed);
+    std::vector<WasteRecord> records = generator.generate(rows);
+    const std::string companyName = generator.mostFrequentCompanyName();
+    const std::string frequentWasteName = generator.mostFrequentWasteName();
+    const std::string wasteName = records.front().wasteName;
+    const std::string removalDate = records.front().removalDate;
+
+    Queue queue;
+
+    BenchmarkResult enqueueResult{ "enqueue", rows, {}, 0.0 };
+    const Clock::time_point enqueueStart = Clock::now();
+    for (std::size_t begin = 0; begin < rows; begin += OPERATION_BATCH_SIZE) {
+        const std::size_t end = std::min(begin + OPERATION_BATCH_SIZE, rows);
+        const Clock::time_point start = Clock::now();
+        for (std::size_t i = begin; i < end; ++i) {
+            enqueue(queue, std::move(records[i]));
+        }
+        enqueueResult.samplesNs.push_back(elapsedNs(start, Clock::now()) / (end - begin));
+    }
+    enqueueResult.throughput = rows / (elapsedNs(enqueueStart, Clock::now()) / 1e9);
+    results.push_back(enqueueResult);
+    std::vector<WasteRecord>().swap(records);
+
+    results.push_back(measureWholeQueue("saveQueueToFile", rows, runs, [&](int) {
+        saveQueueToFile(queue, textFile);
+    }));
+    results.push_back(measureWholeQueue("saveQueueToCompressedFile", rows, runs, [&](int) {
+        saveQueueToCompressedFile(queue, compressedFile);
+    }));
+    results.push_back(measureWholeQueue("loadQueueFromFile (текст)", rows, runs, [&](int) {
+        loadQueueFromFile(queue, textFile);
+    }));
+    results.push_back(measureWholeQueue("loadQueueFromFile (стиснутий)", rows, runs, [&](int) {
+        loadQueueFromFile(queue, compressedFile);
+    }));
+
+    {
+        // Кожен повтор відкриває файл заново, щоб вимірювати холодні індекс і стовпці.
+        std::unique_ptr<MappedRecordFile> mappedFile;
+        auto openAndIndex = [&](int) {
+            mappedFile.reset();
+            mappedFile = std::make_unique<MappedRecordFile>(textFile);
+            resultSink = resultSink + mappedFile->recordCount();
+        };
+        results.push_back(measureWithSetup("MappedRecordFile (відкриття та індекс)", rows, runs, [&](int) {
+            mappedFile.reset();
+        }, openAndIndex));
+        results.push_back(measureWithSetup("MappedRecordFile: перший звіт", rows, runs, openAndIndex, [&](int) {
+            resultSink = resultSink + companiesByPhysicalState(*mappedFile, PhysicalState::Liquid).size();
+        }));
+        results.push_back(measureWithSetup("MappedRecordFile::materialize", rows, runs, openAndIndex, [&](int) {
+            mappedFile->materialize(queue);
+        }));
+    }
+
+    results.push_back(measureWholeQueue("companiesByWasteAndDate", rows, runs, [&](int) {
+        resultSink = resultSink + companiesByWasteAndDate(queue, wasteName, removalDate).size();
+    }));
+    results.push_back(measureWholeQueue("costByCompanyAndWaste", rows, runs, [&](int) {
+        resultSink = resultSink + costByCompanyAndWaste(queue, companyName, frequentWasteName).matchedRecords;
+    }));
+    results.push_back(measureWholeQueue("companiesByPhysicalState", rows, runs, [&](int) {
+        resultSink = resultSink + companiesByPhysicalState(queue, PhysicalState::Liquid).size();
+    }));
+    results.push_back(measureWholeQueue("quantityByCompanyAndDateRange", rows, runs, [&](int) {
+        resultSink = resultSink + quantityByCompanyAndDateRange(queue, companyName, "01:01:2018", "31:12:2020").matchedRecords;
+    }));
+
+    results.push_back(measureWholeQueue("buildTrendReport", rows, runs, [&](int) {
+        resultSink = resultSink + buildTrendReport(queue).weekly.size();
+    }));
+
+    {
+        // Перший виклик заповнює кеш; далі вимірюються лише попадання.
+        ReportCache reportCache(queue);
+        reportCache.costByCompanyAndWaste(companyName, frequentWasteName);
+        results.push_back(measurePerCall("ReportCache: costByCompanyAndWaste (кеш)", rows, runs, [&]() {
+            resultSink = resultSink + reportCache.costByCompanyAndWaste(companyName, frequentWasteName).matchedRecords;
+        }));
+    }
+
+    // Телефон чергується, щоб кожен повтор дійсно змінював записи.
+    const RecordPredicate frequentCompany = makeRecordPredicate({ { RecordField::CompanyName, ComparisonOperator::Equal, companyName } });
+    results.push_back(measureWholeQueue("updateWhere (телефон підприємства)", rows, runs, [&](const int run) {
+        resultSink = resultSink + updateWhere(queue, frequentCompany, RecordField::Phone, run % 2 == 0 ? "000-000-00-00" : "000-000-00-01");
+    }));
+    const RecordPredicate before2018 = makeRecordPredicate({ { RecordField::RemovalDate, ComparisonOperator::Less, "01:01:2018" } });
+    results.push_back(measureWithSetup("deleteWhere (дата до 2018)", rows, runs, [&](int) {
+        loadQueueFromFile(queue, textFile);
+    }, [&](int) {
+        resultSink = resultSink + deleteWhere(queue, before2018);
+    }));
+    loadQueueFromFile(queue, textFile);
+
+    results.push_back(measureWholeQueue("PickupPriorityView (побудова купи)", rows, runs, [&](int) {
+        PickupPriorityView pickupView(queue);
+        resultSink = resultSink + pickupView.size();
+    }));
+    {
+        PickupPriorityView pickupView(queue);
+        BenchmarkResult popResult{ "PickupPriorityView::popNext", rows, {}, 0.0 };
+        const Clock::time_point popStart = Clock::now();
+        while (!pickupView.empty()) {
+            std::size_t batch = 0;
+            const Clock::time_point start = Clock::now();
+            while (batch < OPERATION_BATCH_SIZE && !pickupView.empty()) {
+                pickupView.popNext();
+                ++batch;
+            }
+            popResult.samplesNs.push_back(elapsedNs(start, Clock::now()) / batch);
+        }
+        popResult.throughput = rows / (elapsedNs(popStart, Clock::now()) / 1e9);
+        results.push_back(popResult);
+    }
+    loadQueueFromFile(queue, textFile);
+
+    {
+        // Обидва файли містять ті самі записи, тож половина прочитаного - дублікати.
+        Queue mergedQueue;
+        const std::vector<std::string> mergeFiles = { textFile, compressedFile };
+        MergeLoadStats mergeStats;
+        results.push_back(measureWithSetup("mergeQueueFromFiles (2 файли)", rows, runs, [&](int) {
+            clearQueue(mergedQueue);
+        }, [&](int) {
+            mergeQueueFromFiles(mergedQueue, mergeFiles, mergeStats);
+        }));
+        resultSink = resultSink + mergeStats.duplicatesSkipped;
+        clearQueue(mergedQueue);
+    }
+
+    // Напрямок чергується, щоб кожен повтор дійсно переставляв записи.
+    results.push_back(measureWholeQueue("sortQueueByQuantityThenCost", rows, runs, [&](const int run) {
+        sortQueueByQuantityThenCost(queue, run % 2 == 0 ? SortingDirection::ASC : SortingDirection::DESC);
+    }));
+
+    BenchmarkResult dequeueResult{ "dequeue", rows, {}, 0.0 };
+    const Clock::time_point dequeueStart = Clock::now();
+    while (!isEmpty(queue)) {
+        std::size_t batch = 0;
+        const Clock::time_point start = Clock::now();
+        while (batch < OPERATION_BATCH_SIZE && !isEmpty(queue)) {
+            dequeue(queue);
+            ++batch;
+        }
+        dequeueResult.samplesNs.push_back(elapsedNs(start, Clock::now()) / batch);
+    }
+    dequeueResult.throughput = rows / (elapsedNs(dequeueStart, Clock::now()) / 1e9);
+    results.push_back(dequeueResult);
+
+    std::filesystem::remove(textFile);
+    std::filesystem::remove(compressedFile);
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::size_t> sizes;
+    int runs = 5;
+    std::uint64_t seed = 20231015;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        try {
+            if (argument == "--runs" && i + 1 < argc) {
+                runs = std::max(1, std::stoi(argv[++i]));
+            } else if (argument == "--seed" && i + 1 < argc) {
+                seed = std::stoull(argv[++i]);
+            } else {
+                sizes.push_back(std::stoull(argument));
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Використання: " << argv[0] << " [кількість_рядків ...] [--runs N] [--seed N]\n";
+            return 1;
+        }
+    }
+    if (sizes.empty()) {
+        sizes = { 10000, 100000, 1000000 };
+    }
+
+    printRow("Операція", "Рядків", "Вимірів", "Рядків/с", "p50", "p99");
+
+    for (const std::size_t rows : sizes) {
+        if (rows == 0) {
+            continue;
+        }
+        for (const BenchmarkResult& result : runSuite(rows, runs, seed)) {
+            printResult(result);
+        }
+    }
+    return 0;
+}
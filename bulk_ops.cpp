@@ -0,0 +1,330 @@
+#include "bulk_ops.h"
+
+#include "metrics.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t BULK_CHUNK_SIZE = 4096;
+
+template<typename T>
+bool compareValues(const T& left, const ComparisonOperator op, const T& right) {
+    switch (op) {
+    case ComparisonOperator::Equal: return left == right;
+    case ComparisonOperator::NotEqual: return !(left == right);
+    case ComparisonOperator::Less: return left < right;
+    case ComparisonOperator::LessOrEqual: return !(right < left);
+    case ComparisonOperator::Greater: return right < left;
+    case ComparisonOperator::GreaterOrEqual: return !(left < right);
+    default: return false;
+    }
+}
+
+bool hasDateShape(const std::string& date) {
+    if (date.length() != 10 || date[2] != ':' || date[5] != ':') {
+        return false;
+    }
+    for (std::size_t i = 0; i < date.length(); ++i) {
+        if (i != 2 && i != 5 && !std::isdigit(static_cast<unsigned char>(date[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Порівнює ДД:ММ:РРРР із ключем РРРРММДД без виділення пам'яті під кожен запис.
+int compareDateWithKey(const std::string& date, const std::string& key) {
+    static constexpr std::size_t ORDER[] = { 6, 7, 8, 9, 3, 4, 0, 1 };
+    for (std::size_t i = 0; i < 8; ++i) {
+        const char left = date[ORDER[i]];
+        if (left != key[i]) {
+            return left < key[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+int parseWholeInt(const std::string& value, const std::string& what) {
+    std::size_t parsed = 0;
+    int result;
+    try {
+        result = std::stoi(value, &parsed);
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Некоректне значення поля '" + what + "': " + value);
+    }
+    if (parsed != value.size()) {
+        throw std::invalid_argument("Некоректне значення поля '" + what + "': " + value);
+    }
+    return result;
+}
+
+double parseWholeDouble(const std::string& value, const std::string& what) {
+    std::size_t parsed = 0;
+    double result;
+    try {
+        result = std::stod(value, &parsed);
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Некоректне значення поля '" + what + "': " + value);
+    }
+    if (parsed != value.size()) {
+        throw std::invalid_argument("Некоректне значення поля '" + what + "': " + value);
+    }
+    return result;
+}
+
+std::string WasteRecord::* stringMember(const RecordField field) {
+    switch (field) {
+    case RecordField::CompanyCode: return &WasteRecord::companyCode;
+    case RecordField::CompanyName: return &WasteRecord::companyName;
+    case RecordField::Address: return &WasteRecord::address;
+    case RecordField::Phone: return &WasteRecord::phone;
+    case RecordField::WasteCode: return &WasteRecord::wasteCode;
+    case RecordField::WasteName: return &WasteRecord::wasteName;
+    default: throw std::invalid_argument("Поле не є текстовим.");
+    }
+}
+
+RecordPredicate makeConditionPredicate(const RecordCondition& condition) {
+    if (!isValidRecordField(static_cast<int>(condition.field))) {
+        throw std::invalid_argument("Такого поля запису не існує.");
+    }
+    if (!isValidComparisonOperator(static_cast<int>(condition.op))) {
+        throw std::invalid_argument("Такого оператора порівняння не існує.");
+    }
+
+    const ComparisonOperator op = condition.op;
+    const std::string fieldName = getRecordFieldString(condition.field);
+    switch (condition.field) {
+    case RecordField::State: {
+        const int state = parseWholeInt(condition.value, fieldName);
+        if (!isValidPhysicalState(state)) {
+            throw std::invalid_argument("Некоректний агрегатний стан: " + condition.value);
+        }
+        return [op, state](const WasteRecord& record) {
+            return compareValues(static_cast<int>(record.state), op, state);
+        };
+    }
+    case RecordField::RemovalDate: {
+        if (!hasDateShape(condition.value)) {
+            throw std::invalid_argument("Дата має бути у форматі ДД:ММ:РРРР: " + condition.value);
+        }
+        const std::string key = convertDateToComparableFormat(condition.value);
+        return [op, key](const WasteRecord& record) {
+            return hasDateShape(record.removalDate) && compareValues(compareDateWithKey(record.removalDate, key), op, 0);
+        };
+    }
+    case RecordField::Quantity: {
+        const int quantity = parseWholeInt(condition.value, fieldName);
+        return [op, quantity](const WasteRecord& record) { return compareValues(record.quantity, op, quantity); };
+    }
+    case RecordField::Cost: {
+        const double cost = parseWholeDouble(condition.value, fieldName);
+        return [op, cost](const WasteRecord& record) { return compareValues(record.cost, op, cost); };
+    }
+    default: {
+        std::string WasteRecord::* member = stringMember(condition.field);
+        const std::string value = condition.value;
+        return [op, member, value](const WasteRecord& record) { return compareValues(record.*member, op, value); };
+    }
+    }
+}
+
+// Перевіряє нове значення один раз і повертає функцію, що записує його в запис.
+std::function<void(WasteRecord&)> makeFieldAssignment(const RecordField field, const std::string& newValue) {
+    if (!isValidRecordField(static_cast<int>(field))) {
+        throw std::invalid_argument("Такого поля запису не існує.");
+    }
+
+    const std::string fieldName = getRecordFieldString(field);
+    switch (field) {
+    case RecordField::State: {
+        const int state = parseWholeInt(newValue, fieldName);
+        if (!isValidPhysicalState(state)) {
+            throw std::invalid_argument("Некоректний агрегатний стан: " + newValue);
+        }
+        return [state](WasteRecord& record) { record.state = static_cast<PhysicalState>(state); };
+    }
+    case RecordField::RemovalDate: {
+        if (!isValidDate(newValue)) {
+            throw std::invalid_argument("Некоректна дата: " + newValue);
+        }
+        return [newValue](WasteRecord& record) { record.removalDate = newValue; };
+    }
+    case RecordField::Quantity: {
+        const int quantity = parseWholeInt(newValue, fieldName);
+        if (quantity < MIN_QUANTITY) {
+            throw std::invalid_argument("Кількість має бути не менше 1.");
+        }
+        return [quantity](WasteRecord& record) { record.quantity = quantity; };
+    }
+    case RecordField::Cost: {
+        const double cost = parseWholeDouble(newValue, fieldName);
+        if (!(cost >= MIN_COST)) {
+            throw std::invalid_argument("Вартість має бути не менше 0.01.");
+        }
+        return [cost](WasteRecord& record) { record.cost = cost; };
+    }
+    default: {
+        if (!isValidTextField(newValue)) {
+            throw std::invalid_argument("Значення поля '" + fieldName + "' не може збігатися з роздільником записів.");
+        }
+        std::string WasteRecord::* member = stringMember(field);
+        return [member, newValue](WasteRecord& record) { record.*member = newValue; };
+    }
+    }
+}
+
+std::vector<WasteNode*> collectNodes(const Queue& queue) {
+    std::vector<WasteNode*> nodes;
+    nodes.reserve(queue.size);
+    for (WasteNode* current = queue.head; current != nullptr; current = current->next) {
+        nodes.push_back(current);
+    }
+    return nodes;
+}
+
+// Паралельно позначає вузли, що задовольняють умову.
+std::vector<unsigned char> markMatches(const std::vector<WasteNode*>& nodes, const RecordPredicate& predicate) {
+    std::vector<unsigned char> matches(nodes.size(), 0);
+    parallelFor(nodes.size(), BULK_CHUNK_SIZE, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            matches[i] = predicate(nodes[i]->data) ? 1 : 0;
+        }
+    });
+    return matches;
+}
+
+} // namespace
+
+bool isValidRecordField(const int fieldInt) {
+    return fieldInt >= static_cast<int>(RecordField::CompanyCode) && fieldInt <= static_cast<int>(RecordField::Cost);
+}
+
+std::string getRecordFieldString(const RecordField field) {
+    switch (field) {
+    case RecordField::CompanyCode: return "Код підприємства";
+    case RecordField::CompanyName: return "Назва підприємства";
+    case RecordField::Address: return "Адреса";
+    case RecordField::Phone: return "Телефон";
+    case RecordField::WasteCode: return "Код відходу";
+    case RecordField::WasteName: return "Назва відходу";
+    case RecordField::State: return "Агрегатний стан";
+    case RecordField::RemovalDate: return "Дата вивезення";
+    case RecordField::Quantity: return "Кількість";
+    case RecordField::Cost: return "Вартість";
+    default: throw std::invalid_argument("Такого поля запису не існує.");
+    }
+}
+
+bool isValidComparisonOperator(const int operatorInt) {
+    return operatorInt >= static_cast<int>(ComparisonOperator::Equal) &&
+        operatorInt <= static_cast<int>(ComparisonOperator::GreaterOrEqual);
+}
+
+std::string getComparisonOperatorString(const ComparisonOperator op) {
+    switch (op) {
+    case ComparisonOperator::Equal: return "=";
+    case ComparisonOperator::NotEqual: return "!=";
+    case ComparisonOperator::Less: return "<";
+    case ComparisonOperator::LessOrEqual: return "<=";
+    case ComparisonOperator::Greater: return ">";
+    case ComparisonOperator::GreaterOrEqual: return ">=";
+    default: throw std::invalid_argument("Такого оператора порівняння не існує.");
+    }
+}
+
+RecordPredicate makeRecordPredicate(const std::vector<RecordCondition>& conditions) {
+    std::vector<RecordPredicate> parts;
+    parts.reserve(conditions.size());
+    for (const RecordCondition& condition : conditions) {
+        parts.push_back(makeConditionPredicate(condition));
+    }
+    return [parts](const WasteRecord& record) {
+        return std::all_of(parts.begin(), parts.end(), [&record](const RecordPredicate& part) { return part(record); });
+    };
+}
+
+std::size_t countWhere(const Queue& queue, const RecordPredicate& predicate) {
+    const std::vector<unsigned char> matches = markMatches(collectNodes(queue), predicate);
+    return static_cast<std::size_t>(std::count(matches.begin(), matches.end(), 1));
+}
+
+std::size_t updateWhere(Queue& queue, const RecordPredicate& predicate, const RecordField field,
+                        const std::string& newValue) {
+    ILONA_TIME_OPERATION(MetricOperation::BulkUpdate);
+    const std::function<void(WasteRecord&)> assign = makeFieldAssignment(field, newValue);
+    const std::vector<WasteNode*> nodes = collectNodes(queue);
+
+    // Без спостерігачів поле записується в тому ж паралельному проході.
+    if (queue.listeners.empty()) {
+        std::vector<std::size_t> chunkCounts((nodes.size() + BULK_CHUNK_SIZE - 1) / BULK_CHUNK_SIZE, 0);
+        parallelFor(nodes.size(), BULK_CHUNK_SIZE, [&](const std::size_t begin, const std::size_t end) {
+            std::size_t updated = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                if (predicate(nodes[i]->data)) {
+                    assign(nodes[i]->data);
+                    ++updated;
+                }
+            }
+            chunkCounts[begin / BULK_CHUNK_SIZE] = updated;
+        });
+        std::size_t updated = 0;
+        for (const std::size_t count : chunkCounts) {
+            updated += count;
+        }
+        return updated;
+    }
+
+    // Спостерігачам потрібні старі дані запису, тому заміна йде через replaceRecord.
+    const std::vector<unsigned char> matches = markMatches(nodes, predicate);
+    std::size_t updated = 0;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (matches[i]) {
+            WasteRecord record = nodes[i]->data;
+            assign(record);
+            replaceRecord(queue, *nodes[i], std::move(record));
+            ++updated;
+        }
+    }
+    return updated;
+}
+
+std::size_t deleteWhere(Queue& queue, const RecordPredicate& predicate) {
+    ILONA_TIME_OPERATION(MetricOperation::BulkDelete);
+    const std::vector<WasteNode*> nodes = collectNodes(queue);
+    const std::vector<unsigned char> matches = markMatches(nodes, predicate);
+
+    // Один прохід: вузли, що залишаються, перезв'язуються по порядку, решта звільняються.
+    WasteNode* newHead = nullptr;
+    WasteNode* newTail = nullptr;
+    std::size_t deleted = 0;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        WasteNode* node = nodes[i];
+        if (matches[i]) {
+            for (QueueListener* listener : queue.listeners) {
+                listener->onRecordRemoved(*node);
+            }
+            delete node;
+            ++deleted;
+            continue;
+        }
+        if (newTail != nullptr) {
+            newTail->next = node;
+        } else {
+            newHead = node;
+        }
+        node->prev = newTail;
+        newTail = node;
+    }
+    if (newTail != nullptr) {
+        newTail->next = nullptr;
+    }
+    queue.head = newHead;
+    queue.tail = newTail;
+    queue.size -= deleted;
+    return deleted;
+}
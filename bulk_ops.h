@@ -0,0 +1,64 @@
+#ifndef ILONA_BULK_OPS_H
+#define ILONA_BULK_OPS_H
+
+#include "waste_queue.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Масові операції над чергою: оновлення поля та видалення записів за умовою.
+// Умова перевіряється для всіх записів паралельно, потім черга змінюється
+// одним послідовним проходом; спостерігачі черги отримують звичайні сповіщення.
+
+enum class RecordField {
+    CompanyCode = 1,
+    CompanyName = 2,
+    Address = 3,
+    Phone = 4,
+    WasteCode = 5,
+    WasteName = 6,
+    State = 7,
+    RemovalDate = 8,
+    Quantity = 9,
+    Cost = 10
+};
+
+enum class ComparisonOperator {
+    Equal = 1,
+    NotEqual = 2,
+    Less = 3,
+    LessOrEqual = 4,
+    Greater = 5,
+    GreaterOrEqual = 6
+};
+
+// Умова "поле оператор значення". Дати порівнюються хронологічно, кількість
+// і вартість - як числа, агрегатний стан - за кодом, решта полів - як рядки.
+struct RecordCondition {
+    RecordField field;
+    ComparisonOperator op;
+    std::string value;
+};
+
+// Викликається з кількох потоків одночасно, тому не має змінювати спільний стан.
+using RecordPredicate = std::function<bool(const WasteRecord&)>;
+
+bool isValidRecordField(int fieldInt);
+std::string getRecordFieldString(RecordField field);
+bool isValidComparisonOperator(int operatorInt);
+std::string getComparisonOperatorString(ComparisonOperator op);
+
+// Об'єднує умови через "І"; порожній список відповідає всім записам.
+// Кидає std::invalid_argument, якщо значення не відповідає типу поля.
+RecordPredicate makeRecordPredicate(const std::vector<RecordCondition>& conditions);
+
+std::size_t countWhere(const Queue& queue, const RecordPredicate& predicate);
+// Записує newValue у поле field кожного запису, що задовольняє умову; повертає кількість змінених.
+// Кидає std::invalid_argument, якщо newValue не проходить ті самі перевірки, що й ввід з консолі.
+std::size_t updateWhere(Queue& queue, const RecordPredicate& predicate, RecordField field, const std::string& newValue);
+// Видаляє всі записи, що задовольняють умову, зберігаючи порядок решти; повертає кількість видалених.
+std::size_t deleteWhere(Queue& queue, const RecordPredicate& predicate);
+
+#endif
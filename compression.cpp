@@ -0,0 +1,372 @@
+#include "compression.h"
+
+#include "parallel.h"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace {
+
+const char HEADER_MAGIC[4] = { 'I', 'W', 'Z', 'B' };
+const char FOOTER_MAGIC[4] = { 'I', 'W', 'Z', 'E' };
+constexpr std::uint8_t CONTAINER_VERSION = 1;
+constexpr std::size_t HEADER_SIZE = 8;
+constexpr std::size_t INDEX_ENTRY_SIZE = 25;
+constexpr std::size_t FOOTER_SIZE = 16;
+
+constexpr std::size_t LZ4_MIN_MATCH = 4;
+constexpr std::size_t LZ4_LAST_LITERALS = 5;
+constexpr std::size_t LZ4_MF_LIMIT = 12;
+constexpr std::size_t LZ4_MAX_OFFSET = 65535;
+// Кожен байт блоку LZ4 розгортається щонайбільше у 255 байтів.
+constexpr std::uint64_t LZ4_MAX_EXPANSION = 255;
+constexpr unsigned int LZ4_HASH_BITS = 16;
+
+std::uint32_t read32(const unsigned char* p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+void putLittleEndian(std::string& out, std::uint64_t value, const int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+std::uint64_t getLittleEndian(const char* p, const int bytes) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return value;
+}
+
+void putLength(std::string& out, std::size_t length) {
+    while (length >= 255) {
+        out.push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    out.push_back(static_cast<char>(length));
+}
+
+void emitSequence(std::string& out, const unsigned char* literals, const std::size_t literalLength,
+                  const std::size_t offset, const std::size_t matchLength) {
+    const std::size_t matchCode = matchLength - LZ4_MIN_MATCH;
+    const unsigned char token = static_cast<unsigned char>(
+        (std::min<std::size_t>(literalLength, 15) << 4) | std::min<std::size_t>(matchCode, 15));
+    out.push_back(static_cast<char>(token));
+    if (literalLength >= 15) {
+        putLength(out, literalLength - 15);
+    }
+    out.append(reinterpret_cast<const char*>(literals), literalLength);
+    putLittleEndian(out, offset, 2);
+    if (matchCode >= 15) {
+        putLength(out, matchCode - 15);
+    }
+}
+
+void emitLastLiterals(std::string& out, const unsigned char* literals, const std::size_t literalLength) {
+    out.push_back(static_cast<char>(std::min<std::size_t>(literalLength, 15) << 4));
+    if (literalLength >= 15) {
+        putLength(out, literalLength - 15);
+    }
+    out.append(reinterpret_cast<const char*>(literals), literalLength);
+}
+
+std::uint32_t checksum32(const std::string& data) {
+    // FNV-1a
+    std::uint32_t hash = 2166136261u;
+    for (const char c : data) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+std::string decodeBlock(const char* data, const BlockIndexEntry& entry) {
+    std::string raw;
+    try {
+        switch (entry.codec) {
+        case BlockCodec::Raw:
+            if (entry.compressedSize != entry.rawSize) {
+                throw std::runtime_error("Пошкоджений блок: неправильний розмір");
+            }
+            raw.assign(data, entry.rawSize);
+            break;
+        case BlockCodec::LZ4:
+            raw = lz4DecompressBlock(data, entry.compressedSize, entry.rawSize);
+            break;
+        default:
+            throw std::runtime_error("Невідомий кодек блоку");
+        }
+    } catch (const std::bad_alloc&) {
+        throw std::runtime_error("Пошкоджений блок: не вдалося виділити пам'ять під розпакований блок");
+    } catch (const std::length_error&) {
+        throw std::runtime_error("Пошкоджений блок: неправильний розмір");
+    }
+    if (checksum32(raw) != entry.checksum) {
+        throw std::runtime_error("Пошкоджений блок: контрольна сума не збігається");
+    }
+    return raw;
+}
+
+} // namespace
+
+std::string lz4CompressBlock(const std::string& input) {
+    const std::size_t size = input.size();
+    const auto* src = reinterpret_cast<const unsigned char*>(input.data());
+
+    std::string out;
+    out.reserve(size + size / 255 + 16);
+
+    std::size_t anchor = 0;
+    if (size >= LZ4_MF_LIMIT + 1) {
+        // Позиції зберігаються зі зсувом +1, щоб 0 означав порожню комірку.
+        std::vector<std::uint32_t> table(std::size_t(1) << LZ4_HASH_BITS, 0);
+        const std::size_t matchLimit = size - LZ4_LAST_LITERALS;
+        const std::size_t lastMatchStart = size - LZ4_MF_LIMIT;
+        std::size_t pos = 0;
+
+        while (pos <= lastMatchStart) {
+            const std::uint32_t sequence = read32(src + pos);
+            const std::uint32_t hash = (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+            const std::size_t candidate = table[hash];
+            table[hash] = static_cast<std::uint32_t>(pos + 1);
+
+            if (candidate == 0 || pos - (candidate - 1) > LZ4_MAX_OFFSET ||
+                read32(src + candidate - 1) != sequence) {
+                ++pos;
+                continue;
+            }
+
+            const std::size_t matchPos = candidate - 1;
+            std::size_t matchLength = LZ4_MIN_MATCH;
+            while (pos + matchLength < matchLimit && src[matchPos + matchLength] == src[pos + matchLength]) {
+                ++matchLength;
+            }
+
+            emitSequence(out, src + anchor, pos - anchor, pos - matchPos, matchLength);
+            pos += matchLength;
+            anchor = pos;
+        }
+    }
+    emitLastLiterals(out, src + anchor, size - anchor);
+    return out;
+}
+
+std::string lz4DecompressBlock(const char* data, const std::size_t size, const std::size_t rawSize) {
+    const auto* src = reinterpret_cast<const unsigned char*>(data);
+    const unsigned char* const srcEnd = src + size;
+
+    std::string out(rawSize, '\0');
+    auto* dst = reinterpret_cast<unsigned char*>(&out[0]);
+    std::size_t written = 0;
+
+    auto readLength = [&](std::size_t length) {
+        if (length != 15) {
+            return length;
+        }
+        unsigned char next;
+        do {
+            if (src >= srcEnd) {
+                throw std::runtime_error("Пошкоджений блок LZ4: обрізана довжина");
+            }
+            next = *src++;
+            length += next;
+        } while (next == 255);
+        return length;
+    };
+
+    while (src < srcEnd) {
+        const unsigned char token = *src++;
+
+        const std::size_t literalLength = readLength(token >> 4);
+        if (literalLength > static_cast<std::size_t>(srcEnd - src) || literalLength > rawSize - written) {
+            throw std::runtime_error("Пошкоджений блок LZ4: літерали виходять за межі");
+        }
+        std::memcpy(dst + written, src, literalLength);
+        src += literalLength;
+        written += literalLength;
+
+        if (src == srcEnd) {
+            break;
+        }
+
+        if (srcEnd - src < 2) {
+            throw std::runtime_error("Пошкоджений блок LZ4: обрізане зміщення");
+        }
+        const std::size_t offset = src[0] | (src[1] << 8);
+        src += 2;
+        if (offset == 0 || offset > written) {
+            throw std::runtime_error("Пошкоджений блок LZ4: неправильне зміщення");
+        }
+
+        const std::size_t matchLength = readLength(token & 0x0F) + LZ4_MIN_MATCH;
+        if (matchLength > rawSize - written) {
+            throw std::runtime_error("Пошкоджений блок LZ4: збіг виходить за межі");
+        }
+        // Збіг може перекриватися з щойно записаними байтами, тому копіюємо побайтово.
+        const unsigned char* match = dst + written - offset;
+        for (std::size_t i = 0; i < matchLength; ++i) {
+            dst[written + i] = match[i];
+        }
+        written += matchLength;
+    }
+
+    if (written != rawSize) {
+        throw std::runtime_error("Пошкоджений блок LZ4: неправильний розмір після розпакування");
+    }
+    return out;
+}
+
+bool isBlockContainerFile(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    char magic[4];
+    if (!in.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, HEADER_MAGIC, sizeof(magic)) == 0;
+}
+
+BlockFileWriter::BlockFileWriter(const std::string& filename)
+    : out(filename, std::ios::binary | std::ios::trunc), position(0) {
+    if (!out.is_open()) {
+        return;
+    }
+    std::string header(HEADER_MAGIC, sizeof(HEADER_MAGIC));
+    header.push_back(static_cast<char>(CONTAINER_VERSION));
+    header.append(3, '\0');
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    position = header.size();
+}
+
+bool BlockFileWriter::isOpen() const {
+    return out.is_open();
+}
+
+void BlockFileWriter::addBlock(const std::string& raw, const std::uint32_t recordCount) {
+    std::string compressed = lz4CompressBlock(raw);
+    BlockCodec codec = BlockCodec::LZ4;
+    // Нестисливі дані зберігаємо як є.
+    if (compressed.size() >= raw.size()) {
+        compressed = raw;
+        codec = BlockCodec::Raw;
+    }
+
+    index.push_back(BlockIndexEntry{ position, static_cast<std::uint32_t>(compressed.size()),
+                                     static_cast<std::uint32_t>(raw.size()), recordCount, checksum32(raw), codec });
+    out.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+    position += compressed.size();
+}
+
+bool BlockFileWriter::finish() {
+    std::string tail;
+    tail.reserve(index.size() * INDEX_ENTRY_SIZE + FOOTER_SIZE);
+    for (const BlockIndexEntry& entry : index) {
+        putLittleEndian(tail, entry.offset, 8);
+        putLittleEndian(tail, entry.compressedSize, 4);
+        putLittleEndian(tail, entry.rawSize, 4);
+        putLittleEndian(tail, entry.recordCount, 4);
+        putLittleEndian(tail, entry.checksum, 4);
+        tail.push_back(static_cast<char>(entry.codec));
+    }
+    putLittleEndian(tail, index.size(), 4);
+    putLittleEndian(tail, position, 8);
+    tail.append(FOOTER_MAGIC, sizeof(FOOTER_MAGIC));
+    out.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+    // close() скидає буфер на диск; помилка будь-якого з попередніх записів лишається у стані потоку.
+    out.close();
+    return static_cast<bool>(out);
+}
+
+BlockFileReader::BlockFileReader(const std::string& filename)
+    : in(filename, std::ios::binary), indexOffset(0) {
+    if (!in.is_open()) {
+        throw std::runtime_error("Не вдалося відкрити файл: " + filename);
+    }
+
+    in.seekg(0, std::ios::end);
+    const std::uint64_t fileSize = static_cast<std::uint64_t>(in.tellg());
+    if (fileSize < HEADER_SIZE + FOOTER_SIZE) {
+        throw std::runtime_error("Файл занадто короткий для блочного формату: " + filename);
+    }
+
+    char footer[FOOTER_SIZE];
+    in.seekg(static_cast<std::streamoff>(fileSize - FOOTER_SIZE));
+    in.read(footer, FOOTER_SIZE);
+    if (!in || std::memcmp(footer + 12, FOOTER_MAGIC, sizeof(FOOTER_MAGIC)) != 0) {
+        throw std::runtime_error("Файл пошкоджений або не дописаний: " + filename);
+    }
+
+    // Кількість блоків перевіряється до множення, щоб пошкоджена кінцівка не спричинила переповнення.
+    const std::uint64_t count = getLittleEndian(footer, 4);
+    indexOffset = getLittleEndian(footer + 4, 8);
+    if (count > (fileSize - HEADER_SIZE - FOOTER_SIZE) / INDEX_ENTRY_SIZE ||
+        indexOffset < HEADER_SIZE || indexOffset != fileSize - FOOTER_SIZE - count * INDEX_ENTRY_SIZE) {
+        throw std::runtime_error("Пошкоджена таблиця блоків у файлі: " + filename);
+    }
+
+    std::string table(count * INDEX_ENTRY_SIZE, '\0');
+    in.seekg(static_cast<std::streamoff>(indexOffset));
+    in.read(&table[0], static_cast<std::streamsize>(table.size()));
+    if (!in) {
+        throw std::runtime_error("Не вдалося прочитати таблицю блоків: " + filename);
+    }
+
+    index.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const char* p = table.data() + i * INDEX_ENTRY_SIZE;
+        BlockIndexEntry entry{ getLittleEndian(p, 8),
+                               static_cast<std::uint32_t>(getLittleEndian(p + 8, 4)),
+                               static_cast<std::uint32_t>(getLittleEndian(p + 12, 4)),
+                               static_cast<std::uint32_t>(getLittleEndian(p + 16, 4)),
+                               static_cast<std::uint32_t>(getLittleEndian(p + 20, 4)),
+                               static_cast<BlockCodec>(p[24]) };
+        if (entry.offset < HEADER_SIZE || entry.offset > indexOffset || entry.compressedSize > indexOffset - entry.offset) {
+            throw std::runtime_error("Блок виходить за межі даних у файлі: " + filename);
+        }
+        if (entry.rawSize > entry.compressedSize * LZ4_MAX_EXPANSION) {
+            throw std::runtime_error("Неправдоподібний розмір розпакованого блоку у файлі: " + filename);
+        }
+        index.push_back(entry);
+    }
+}
+
+std::size_t BlockFileReader::blockCount() const {
+    return index.size();
+}
+
+const BlockIndexEntry& BlockFileReader::blockInfo(const std::size_t blockIndex) const {
+    return index.at(blockIndex);
+}
+
+std::string BlockFileReader::readBlock(const std::size_t blockIndex) {
+    const BlockIndexEntry& entry = index.at(blockIndex);
+    std::string compressed(entry.compressedSize, '\0');
+    in.clear();
+    in.seekg(static_cast<std::streamoff>(entry.offset));
+    in.read(&compressed[0], static_cast<std::streamsize>(compressed.size()));
+    if (!in) {
+        throw std::runtime_error("Не вдалося прочитати блок #" + std::to_string(blockIndex));
+    }
+    return decodeBlock(compressed.data(), entry);
+}
+
+void BlockFileReader::decodeAllBlocks(
+    const std::function<void(std::size_t blockIndex, const std::string& raw)>& onBlock) {
+    std::string data(indexOffset, '\0');
+    in.clear();
+    in.seekg(0);
+    in.read(&data[0], static_cast<std::streamsize>(data.size()));
+    if (!in) {
+        throw std::runtime_error("Не вдалося прочитати дані блоків");
+    }
+
+    parallelFor(index.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            onBlock(i, decodeBlock(data.data() + index[i].offset, index[i]));
+        }
+    });
+}
@@ -0,0 +1,75 @@
+#ifndef ILONA_COMPRESSION_H
+#define ILONA_COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Блочний контейнер для збережених даних:
+//   заголовок "IWZB" + версія,
+//   стиснуті блоки один за одним,
+//   таблиця блоків (зміщення, розміри, кількість записів, кодек, контрольна сума),
+//   кінцівка: кількість блоків, зміщення таблиці, "IWZE".
+// Кожен блок містить цілі записи і розпаковується незалежно від інших.
+
+enum class BlockCodec : std::uint8_t {
+    Raw = 0,
+    LZ4 = 1
+};
+
+struct BlockIndexEntry {
+    std::uint64_t offset;
+    std::uint32_t compressedSize;
+    std::uint32_t rawSize;
+    std::uint32_t recordCount;
+    std::uint32_t checksum;
+    BlockCodec codec;
+};
+
+// Стиснення у форматі блоку LZ4 (без кадру LZ4).
+std::string lz4CompressBlock(const std::string& input);
+std::string lz4DecompressBlock(const char* data, std::size_t size, std::size_t rawSize);
+
+bool isBlockContainerFile(const std::string& filename);
+
+class BlockFileWriter {
+public:
+    explicit BlockFileWriter(const std::string& filename);
+
+    bool isOpen() const;
+    void addBlock(const std::string& raw, std::uint32_t recordCount);
+    // Дописує таблицю блоків та кінцівку і закриває файл. Без виклику файл вважається
+    // пошкодженим. false - якийсь із записів у файл (зокрема блоків) не вдався.
+    bool finish();
+
+private:
+    std::ofstream out;
+    std::vector<BlockIndexEntry> index;
+    std::uint64_t position;
+};
+
+class BlockFileReader {
+public:
+    // Кидає std::runtime_error, якщо файл не вдалося відкрити або він пошкоджений.
+    explicit BlockFileReader(const std::string& filename);
+
+    std::size_t blockCount() const;
+    const BlockIndexEntry& blockInfo(std::size_t blockIndex) const;
+
+    // Довільний доступ: читає і розпаковує лише один блок.
+    std::string readBlock(std::size_t blockIndex);
+
+    // Читає всі блоки одним послідовним читанням і розпаковує їх паралельно.
+    // onBlock викликається з робочих потоків у довільному порядку.
+    void decodeAllBlocks(const std::function<void(std::size_t blockIndex, const std::string& raw)>& onBlock);
+
+private:
+    std::ifstream in;
+    std::vector<BlockIndexEntry> index;
+    std::uint64_t indexOffset;
+};
+
+#endif
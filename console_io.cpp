@@ -0,0 +1,763 @@
+#include "console_io.h"
+
+#include "metrics.h"
+#include "reports.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+const std::string DEFAULT_FILENAME = "waste_data.txt";
+const std::size_t MAX_NAME_SUGGESTIONS = 10;
+
+void printSingleRecordDetails(const WasteRecord& record, const int recordNumber) {
+    if (recordNumber != -1) {
+         std::cout << "Запис #" << recordNumber << "\n";
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  Код підприємства: " << record.companyCode << "\n";
+    std::cout << "  Назва підприємства: " << record.companyName << "\n";
+    std::cout << "  Адреса:      " << record.address << "\n";
+    std::cout << "  Телефон:        " << record.phone << "\n";
+    std::cout << "  Код відходу:   " << record.wasteCode << "\n";
+    std::cout << "  Назва відходу:   " << record.wasteName << "\n";
+    std::cout << "  Агрегатний стан:        " << getPhysicalStateString(record.state) << "\n";
+    std::cout << "  Дата вивезення: " << record.removalDate << "\n";
+    std::cout << "  Кількість:     " << record.quantity << "\n";
+    std::cout << "  Вартість:         " << record.cost << " грн\n";
+    std::cout << "  ---------------------" << std::endl;
+}
+
+
+void printQueue(const Queue& queue) {
+    if (isEmpty(queue)) {
+        std::cout << "Черга порожня!" << std::endl;
+        return;
+    }
+
+    const WasteNode* current = queue.head;
+    std::cout << "\n===== ВМІСТ ЧЕРГИ =====\n";
+    int recordNumber = 1;
+    while (current != nullptr) {
+        printSingleRecordDetails(current->data, recordNumber++);
+        current = current->next;
+    }
+}
+
+std::string getLineWithPrompt(const std::string& prompt) {
+    std::string input;
+    std::cout << prompt;
+    std::getline(std::cin, input);
+    return input;
+}
+
+// Текстове поле запису: повторює запит, доки значення не можна буде зберегти у файл.
+std::string getTextFieldWithPrompt(const std::string& prompt) {
+    while (true) {
+        const std::string input = getLineWithPrompt(prompt);
+        if (isValidTextField(input)) {
+            return input;
+        }
+        std::cout << "Значення збігається з роздільником записів файлу. Спробуйте ще раз.\n";
+    }
+}
+
+int getIntWithPrompt(const std::string& prompt, const int minVal, const int maxVal) {
+    std::string line;
+    while (true) {
+        std::cout << prompt;
+        std::getline(std::cin, line);
+        try {
+            int value = std::stoi(line);
+            if (value >= minVal && value <= maxVal) {
+                return value;
+            }
+            std::cout << "Значення має бути в діапазоні [" << minVal << ", " << maxVal << "]. Спробуйте ще раз.\n";
+        } catch (const std::invalid_argument&) {
+            std::cout << "Некоректний ввід. Введіть ціле число.\n";
+        } catch (const std::out_of_range&) {
+            std::cout << "Число занадто велике або занадто мале. Спробуйте ще раз.\n";
+        }
+    }
+}
+
+double getDoubleWithPrompt(const std::string& prompt, const double minVal, const double maxVal) {
+    std::string line;
+    while (true) {
+        std::cout << prompt;
+        std::getline(std::cin, line);
+        try {
+            double value = std::stod(line);
+             if (value >= minVal && value <= maxVal) {
+                return value;
+             }
+            std::cout << "Значення має бути в діапазоні [" << minVal << ", " << maxVal << "]. Спробуйте ще раз.\n";
+        } catch (const std::invalid_argument&) {
+            std::cout << "Некоректний ввід. Введіть число (можливо, з десятковою крапкою).\n";
+        } catch (const std::out_of_range&) {
+            std::cout << "Число занадто велике або занадто мале. Спробуйте ще раз.\n";
+        }
+    }
+}
+
+
+bool getYesNoInput(const std::string& prompt) {
+    std::string input;
+    while (true) {
+        std::cout << prompt << " (Y/N): ";
+        std::getline(std::cin, input);
+        if (input.length() == 1) {
+            char choice = static_cast<char>(std::toupper(static_cast<unsigned char>(input[0])));
+            if (choice == 'Y') {
+                return true;
+            }
+            return false;
+        }
+        std::cout << "Некоректний ввід. Будь ласка, введіть Y або N.\n";
+    }
+}
+
+int inputPhysicalState(const std::string& prompt) {
+    int state;
+    std::string line;
+    do {
+        std::cout << prompt <<" (" << static_cast<int>(PhysicalState::Solid) << " = " +
+            getPhysicalStateString(PhysicalState::Solid) + ", " << static_cast<int>(PhysicalState::Liquid) << " = "
+        + getPhysicalStateString(PhysicalState::Liquid) + ", " << static_cast<int>(PhysicalState::Gas) << " = "
+        + getPhysicalStateString(PhysicalState::Gas) + "): ";
+        std::getline(std::cin, line);
+        try {
+            state = std::stoi(line);
+            if (!isValidPhysicalState(state)) {
+                std::cout << "Некоректний стан. Спробуйте ще раз.\n";
+            }
+        } catch (const std::invalid_argument& e) {
+            std::cout << "Некоректний ввід. Введіть число.\n";
+            state = 0;
+        } catch (const std::out_of_range& e) {
+            std::cout << "Число занадто велике. Спробуйте ще раз.\n";
+            state = 0;
+        }
+    } while (!isValidPhysicalState(state));
+
+    return state;
+}
+
+std::string getSortingDirectionString(const SortingDirection direction) {
+    switch (direction) {
+        case SortingDirection::ASC: return "За зростанням";
+        case SortingDirection::DESC: return "За спаданням";
+        default: throw std::invalid_argument("Такого напрямку сортування не існує.");
+    }
+}
+
+bool isValidSortingDirection(int sortingDirection) {
+    return sortingDirection == static_cast<int>(SortingDirection::ASC) ||
+        sortingDirection == static_cast<int>(SortingDirection::DESC);
+}
+
+SortingDirection inputSoringDirection(const std::string& prompt) {
+    int sortingDirection;
+    std::string line;
+    do {
+        std::cout << prompt <<" (" << static_cast<int>(SortingDirection::ASC) << " = " +
+            getSortingDirectionString(SortingDirection::ASC) + ", " << static_cast<int>(SortingDirection::DESC) << " = "
+        + getSortingDirectionString(SortingDirection::DESC) + ")\nВведіть напрямок: ";
+        std::getline(std::cin, line);
+        try {
+            sortingDirection = std::stoi(line);
+            if (!isValidSortingDirection(sortingDirection)) {
+                std::cout << "Некоректний напрямок. Спробуйте ще раз.\n";
+            }
+        } catch (const std::invalid_argument& e) {
+            std::cout << "Некоректний ввід. Введіть число.\n";
+            sortingDirection = 0;
+        } catch (const std::out_of_range& e) {
+            std::cout << "Число занадто велике. Спробуйте ще раз.\n";
+            sortingDirection = 0;
+        }
+    } while (!isValidSortingDirection(sortingDirection));
+
+    return static_cast<SortingDirection>(sortingDirection);
+}
+
+std::string inputDate(const std::string& promptMessage) {
+    std::string date;
+    do {
+        std::cout << promptMessage << " (ДД:ММ:РРРР): ";
+        std::getline(std::cin, date);
+        if (!isValidDate(date)) {
+            std::cout << "Некоректна дата або формат. Спробуйте ще раз.\n";
+        }
+    } while (!isValidDate(date));
+
+    return date;
+}
+
+WasteRecord inputWasteRecord() {
+    const std::string companyCode = getTextFieldWithPrompt("Введіть код підприємства: ");
+    const std::string companyName = getTextFieldWithPrompt("Введіть назву підприємства: ");
+    const std::string address = getTextFieldWithPrompt("Введіть адресу: ");
+    const std::string phone = getTextFieldWithPrompt("Введіть номер телефону: ");
+    const std::string wasteCode = getTextFieldWithPrompt("Введіть код відходу: ");
+    const std::string wasteName = getTextFieldWithPrompt("Введіть назву відходу: ");
+
+    const PhysicalState state = static_cast<PhysicalState>(inputPhysicalState());
+    const std::string removalDate = inputDate("Введіть дату вивезення");
+    const int quantity = getIntWithPrompt("Введіть кількість: ", MIN_QUANTITY);
+    const double cost = getDoubleWithPrompt("Введіть вартість: ", MIN_COST);
+
+    return WasteRecord(companyCode, companyName, address, phone, wasteCode, wasteName,
+                       state, removalDate, quantity, cost);
+}
+
+std::string inputNameWithSuggestions(const std::string& prompt, const NameSearchIndex& index) {
+    const std::string name = getLineWithPrompt(prompt);
+    if (name.empty() || index.contains(name)) {
+        return name;
+    }
+
+    const std::vector<std::string> suggestions = index.suggest(name, MAX_NAME_SUGGESTIONS);
+    if (suggestions.empty()) {
+        return name;
+    }
+
+    std::cout << "Точного збігу для '" << name << "' не знайдено. Можливо, ви мали на увазі:\n";
+    for (std::size_t i = 0; i < suggestions.size(); ++i) {
+        std::cout << "  " << i + 1 << ". " << suggestions[i] << "\n";
+    }
+    const int choice = getIntWithPrompt("Оберіть варіант (0 - залишити введене): ", 0,
+                                        static_cast<int>(suggestions.size()));
+    return choice == 0 ? name : suggestions[choice - 1];
+}
+
+void printCompaniesByWasteAndDateResult(const std::set<std::string>& foundCompanies, const std::string& targetWasteName,
+                                        const std::string& targetDate) {
+    if (foundCompanies.empty()) {
+        std::cout << "Не знайдено підприємств, які вивозили '" << targetWasteName
+                  << "' на дату " << targetDate << ".\n";
+    } else {
+        std::cout << "\nСписок підприємств, які вивозили '" << targetWasteName
+                  << "' на дату " << targetDate << ":\n";
+        for (const std::string& companyName : foundCompanies) {
+            std::cout << "- " << companyName << std::endl;
+        }
+    }
+}
+
+void printServiceCostResult(const CostReport& report, const std::string& targetCompanyName, const std::string& targetWasteName) {
+    std::cout << std::fixed << std::setprecision(2);
+    if (report.matchedRecords > 0) {
+        std::cout << "Загальна вартість вивезення відходу '" << targetWasteName
+                  << "' для підприємства '" << targetCompanyName << "' складає: "
+                  << report.totalCost << " грн.\n";
+    } else {
+        std::cout << "Не знайдено записів для підприємства '" << targetCompanyName
+                  << "' з видом відходу '" << targetWasteName << "' для розрахунку вартості.\n";
+    }
+}
+
+void printCompaniesByPhysicalStateResult(const std::set<std::string>& foundCompanies, const PhysicalState targetState) {
+    const std::string targetStateStr = getPhysicalStateString(targetState);
+    if (foundCompanies.empty()) {
+        std::cout << "Не знайдено підприємств, які вивозять відходи в агрегатному стані: '"
+                  << targetStateStr << "'.\n";
+    } else {
+        std::cout << "\nСписок підприємств, які вивозять відходи в агрегатному стані '"
+                  << targetStateStr << "':\n";
+
+        for (const std::string& companyName : foundCompanies) {
+            std::cout << "- " << companyName << std::endl;
+        }
+    }
+}
+
+void printWasteCountResult(const QuantityReport& report, const std::string& targetCompanyName,
+                           const std::string& startDateStr, const std::string& endDateStr) {
+    if (report.matchedRecords > 0) {
+        std::cout << "Загальна кількість відходів, вивезених підприємством '" << targetCompanyName
+                  << "' з " << startDateStr << " по " << endDateStr << ", складає: "
+                  << report.totalQuantity << " од.\n";
+    } else {
+        std::cout << "Не знайдено записів про вивезення відходів підприємством '" << targetCompanyName
+                  << "' в заданому діапазоні дат (" << startDateStr << " - " << endDateStr << ").\n";
+    }
+}
+
+void printCompaniesByWasteTypeAndDate(const Queue& queue, ReportCache& reportCache, const QueueSearchIndex& searchIndex) {
+    if (isEmpty(queue)) {
+        std::cout << "Черга порожня. Немає даних для пошуку.\n";
+        return;
+    }
+
+    const std::string targetWasteName = inputNameWithSuggestions("Введіть назву виду відходу для пошуку: ", searchIndex.wastes());
+    const std::string targetDate = inputDate("Введіть дату вивезення для пошуку");
+
+    printCompaniesByWasteAndDateResult(reportCache.companiesByWasteAndDate(targetWasteName, targetDate), targetWasteName, targetDate);
+}
+
+void calculateServiceCostByWasteTypeAndCompany(const Queue& queue, ReportCache& reportCache, const QueueSearchIndex& searchIndex) {
+    if (isEmpty(queue)) {
+        std::cout << "Черга порожня. Немає даних для розрахунку.\n";
+        return;
+    }
+
+    const std::string targetCompanyName = inputNameWithSuggestions("Введіть назву підприємства для розрахунку вартості: ", searchIndex.companies());
+    const std::string targetWasteName = inputNameWithSuggestions("Введіть назву виду відходу: ", searchIndex.wastes());
+
+    printServiceCostResult(reportCache.costByCompanyAndWaste(targetCompanyName, targetWasteName), targetCompanyName, targetWasteName);
+}
+
+void findCompaniesByPhysicalState(const Queue& queue, ReportCache& reportCache) {
+    if (isEmpty(queue)) {
+        std::cout << "Черга порожня. Немає даних для пошуку.\n";
+        return;
+    }
+
+    std::cout << "Пошук підприємств за агрегатним станом відходів.\n";
+    const PhysicalState targetState = static_cast<PhysicalState>(inputPhysicalState());
+    printCompaniesByPhysicalStateResult(reportCache.companiesByPhysicalState(targetState), targetState);
+}
+
+void calculateWasteCountByCompanyAndDateRange(const Queue& queue, ReportCache& reportCache, const QueueSearchIndex& searchIndex) {
+    if (isEmpty(queue)) {
+        std::cout << "Черга порожня. Немає даних для розрахунку.\n";
+        return;
+    }
+
+    const std::string targetCompanyName = inputNameWithSuggestions("Введіть назву підприємства для розрахунку кількості відходів: ", searchIndex.companies());
+    const std::string startDateStr = inputDate("Введіть початкову дату діапазону");
+    const std::string endDateStr = inputDate("Введіть кінцеву дату діапазону");
+
+    QuantityReport report;
+    try {
+        report = reportCache.quantityByCompanyAndDateRange(targetCompanyName, startDateStr, endDateStr);
+    } catch (const std::invalid_argument& ex) {
+        std::cout << "Помилка: " << ex.what() << std::endl;
+        return;
+    }
+    printWasteCountResult(report, targetCompanyName, startDateStr, endDateStr);
+}
+
+void printMappedFileRecords(MappedRecordFile& file) {
+    const std::size_t total = file.recordCount();
+    std::cout << "Файл " << file.filename() << ": записів - " << total;
+    if (file.skippedRecords() > 0) {
+        std::cout << ", неповних пропущено - " << file.skippedRecords();
+    }
+    std::cout << "\n";
+    if (total == 0) {
+        return;
+    }
+
+    const int first = getIntWithPrompt("З якого запису почати (1-" + std::to_string(total) + ")? ", 1,
+                                       static_cast<int>(std::min<std::size_t>(total, std::numeric_limits<int>::max())));
+    const int count = getIntWithPrompt("Скільки записів показати? ", 1);
+    const std::size_t end = std::min(total, static_cast<std::size_t>(first - 1) + static_cast<std::size_t>(count));
+    for (std::size_t i = static_cast<std::size_t>(first - 1); i < end; ++i) {
+        if (file.isValidRecord(i)) {
+            printSingleRecordDetails(file.record(i), static_cast<int>(i + 1));
+        } else {
+            std::cout << "Запис #" << i + 1 << " некоректний і буде пропущений при завантаженні.\n";
+        }
+    }
+}
+
+void printCompaniesByWasteTypeAndDate(MappedRecordFile& file) {
+    const std::string targetWasteName = getLineWithPrompt("Введіть назву виду відходу для пошуку: ");
+    const std::string targetDate = inputDate("Введіть дату вивезення для пошуку");
+    printCompaniesByWasteAndDateResult(companiesByWasteAndDate(file, targetWasteName, targetDate), targetWasteName, targetDate);
+}
+
+void calculateServiceCostByWasteTypeAndCompany(MappedRecordFile& file) {
+    const std::string targetCompanyName = getLineWithPrompt("Введіть назву підприємства для розрахунку вартості: ");
+    const std::string targetWasteName = getLineWithPrompt("Введіть назву виду відходу: ");
+    printServiceCostResult(costByCompanyAndWaste(file, targetCompanyName, targetWasteName), targetCompanyName, targetWasteName);
+}
+
+void findCompaniesByPhysicalState(MappedRecordFile& file) {
+    std::cout << "Пошук підприємств за агрегатним станом відходів.\n";
+    const PhysicalState targetState = static_cast<PhysicalState>(inputPhysicalState());
+    printCompaniesByPhysicalStateResult(companiesByPhysicalState(file, targetState), targetState);
+}
+
+void calculateWasteCountByCompanyAndDateRange(MappedRecordFile& file) {
+    const std::string targetCompanyName = getLineWithPrompt("Введіть назву підприємства для розрахунку кількості відходів: ");
+    const std::string startDateStr = inputDate("Введіть початкову дату діапазону");
+    const std::string endDateStr = inputDate("Введіть кінцеву дату діапазону");
+
+    QuantityReport report;
+    try {
+        report = quantityByCompanyAndDateRange(file, targetCompanyName, startDateStr, endDateStr);
+    } catch (const std::invalid_argument& ex) {
+        std::cout << "Помилка: " << ex.what() << std::endl;
+        return;
+    }
+    printWasteCountResult(report, targetCompanyName, startDateStr, endDateStr);
+}
+
+void updateRecord(Queue& queue, const QueueSearchIndex& searchIndex) {
+    if (isEmpty(queue)) {
+        std::cout << "Черга порожня. Немає записів для редагування.\n";
+        return;
+    }
+
+    std::string searchCompanyName = inputNameWithSuggestions("Введіть назву підприємства для пошуку записів: ", searchIndex.companies());
+
+    std::vector<WasteNode*> matchingNodes = findRecordsByCompany(queue, searchCompanyName);
+
+    if (matchingNodes.empty()) {
+        std::cout << "Не знайдено записів для підприємства '" << searchCompanyName << "'.\n";
+        return;
+    }
+
+    std::cout << "\nЗнайдені записи для підприємства '" << searchCompanyName << "':\n";
+    for (size_t i = 0; i < matchingNodes.size(); ++i) {
+        std::cout << "--- Запис #" << i + 1 << " ---\n";
+        printSingleRecordDetails(matchingNodes[i]->data, -1);
+    }
+
+    int choice = getIntWithPrompt("Введіть номер запису для редагування (0 для скасування): ", 0, matchingNodes.size());
+
+    if (choice == 0) {
+        std::cout << "Редагування скасовано.\n";
+        return;
+    }
+
+    WasteNode* nodeToUpdate = matchingNodes[choice - 1];
+
+    std::string companyCode = nodeToUpdate->data.companyCode;
+    std::string companyName = nodeToUpdate->data.companyName;
+    std::string address = nodeToUpdate->data.address;
+    std::string phone = nodeToUpdate->data.phone;
+    std::string wasteCode = nodeToUpdate->data.wasteCode;
+    std::string wasteName = nodeToUpdate->data.wasteName;
+    PhysicalState state = nodeToUpdate->data.state;
+    std::string removalDate = nodeToUpdate->data.removalDate;
+    int quantity = nodeToUpdate->data.quantity;
+    double cost = nodeToUpdate->data.cost;
+
+    std::cout << "\n--- Редагування Запису --- \n";
+    std::cout << "Поточні дані:\n";
+    printSingleRecordDetails(nodeToUpdate->data, -1);
+
+    std::cout << "\nВведіть нові дані (натисніть Enter, щоб не змінювати):\n";
+
+    if (getYesNoInput("Змінити код підприємства (" + companyCode + ")?")) {
+        companyCode = getTextFieldWithPrompt("Новий код підприємства: ");
+    }
+    if (getYesNoInput("Змінити назву підприємства (" + companyName + ")?")) {
+        companyName = getTextFieldWithPrompt("Нова назва підприємства: ");
+    }
+    if (getYesNoInput("Змінити адресу (" + address + ")?")) {
+        address = getTextFieldWithPrompt("Нова адреса: ");
+    }
+    if (getYesNoInput("Змінити телефон (" + phone + ")?")) {
+        phone = getTextFieldWithPrompt("Новий телефон: ");
+    }
+    if (getYesNoInput("Змінити код відходу (" + wasteCode + ")?")) {
+        wasteCode = getTextFieldWithPrompt("Новий код відходу: ");
+    }
+    if (getYesNoInput("Змінити назву відходу (" + wasteName + ")?")) {
+        wasteName = getTextFieldWithPrompt("Нова назва відходу: ");
+    }
+    if (getYesNoInput("Змінити агрегатний стан (" + getPhysicalStateString(state) + ")?")) {
+        state = static_cast<PhysicalState>(inputPhysicalState("Новий агрегатний стан"));
+    }
+    if (getYesNoInput("Змінити дату вивезення (" + removalDate + ")?")) {
+        removalDate = inputDate("Нова дата вивезення");
+    }
+    if (getYesNoInput("Змінити кількість (" + std::to_string(quantity) + ")?")) {
+        quantity = getIntWithPrompt("Нова кількість: ", MIN_QUANTITY);
+    }
+    if (getYesNoInput("Змінити вартість (" + std::to_string(cost) + ")?")) {
+        cost = getDoubleWithPrompt("Нова вартість: ", MIN_COST);
+    }
+
+    std::cout << "\n--- Перевірка змін --- \n";
+    // Створюємо тимчасовий об'єкт з новими даними для друку
+    WasteRecord tempPrintRecord(companyCode, companyName, address, phone, wasteCode, wasteName, state, removalDate, quantity, cost);
+    printSingleRecordDetails(tempPrintRecord, -1);
+
+    if (getYesNoInput("Зберегти ці зміни?")) {
+        // Оновлюємо дані в вузлі черги через replaceRecord, щоб індекси побачили зміну
+        replaceRecord(queue, *nodeToUpdate, WasteRecord(companyCode, companyName, address, phone, wasteCode, wasteName,
+                                                        state, removalDate, quantity, cost));
+        std::cout << "Запис успішно оновлено.\n";
+    } else {
+        std::cout << "Зміни скасовано.\n";
+    }
+}
+
+RecordField inputRecordField(const std::string& prompt) {
+    std::cout << prompt << ":\n";
+    for (int field = static_cast<int>(RecordField::CompanyCode); field <= static_cast<int>(RecordField::Cost); ++field) {
+        std::cout << "  " << field << ". " << getRecordFieldString(static_cast<RecordField>(field)) << "\n";
+    }
+    return static_cast<RecordField>(getIntWithPrompt("Введіть номер поля: ", static_cast<int>(RecordField::CompanyCode),
+                                                     static_cast<int>(RecordField::Cost)));
+}
+
+std::string recordFieldValueHint(const RecordField field) {
+    switch (field) {
+    case RecordField::State:
+        return " (" + std::to_string(static_cast<int>(PhysicalState::Solid)) + " = " + getPhysicalStateString(PhysicalState::Solid) +
+            ", " + std::to_string(static_cast<int>(PhysicalState::Liquid)) + " = " + getPhysicalStateString(PhysicalState::Liquid) +
+            ", " + std::to_string(static_cast<int>(PhysicalState::Gas)) + " = " + getPhysicalStateString(PhysicalState::Gas) + ")";
+    case RecordField::RemovalDate: return " (ДД:ММ:РРРР)";
+    default: return "";
+    }
+}
+
+// Умови відбору для масових операцій; порожній список означає "усі записи".
+std::vector<RecordCondition> inputRecordConditions() {
+    std::vector<RecordCondition> conditions;
+    while (getYesNoInput(conditions.empty() ? "Додати умову відбору?" : "Додати ще одну умову (через \"І\")?")) {
+        const RecordField field = inputRecordField("Поле умови");
+
+        std::cout << "Оператор порівняння:";
+        for (int op = static_cast<int>(ComparisonOperator::Equal); op <= static_cast<int>(ComparisonOperator::GreaterOrEqual); ++op) {
+            std::cout << " " << op << " = " << getComparisonOperatorString(static_cast<ComparisonOperator>(op)) << ";";
+        }
+        std::cout << "\n";
+        const ComparisonOperator op = static_cast<ComparisonOperator>(getIntWithPrompt("Введіть номер оператора: ",
+            static_cast<int>(ComparisonOperator::Equal), static_cast<int>(ComparisonOperator::GreaterOrEqual)));
+
+        const std::string value = getLineWithPrompt("Значення" + recordFieldValueHint(field) + ": ");
+        conditions.push_back(RecordCondition{ field, op, value });
+    }
+    return conditions;
+}
+
+std::string describeConditions(const std::vector<RecordCondition>& conditions) {
+    if (conditions.empty()) {
+        return "усі записи";
+    }
+    std::string description;
+    for (const RecordCondition& condition : conditions) {
+        if (!description.empty()) {
+            description += " І ";
+        }
+        description += getRecordFieldString(condition.field) + " " + getComparisonOperatorString(condition.op) +
+            " '" + condition.value + "'";
+    }
+    return description;
+}
+
+void bulkUpdateRecords(Queue& queue) {
+    if (isEmpty(queue)) {
+        std::cout << "Черга порожня. Немає записів для оновлення.\n";
+        return;
+    }
+
+    std::cout << "Масове оновлення поля за умовою.\n";
+    const std::vector<RecordCondition> conditions = inputRecordConditions();
+    RecordPredicate predicate;
+    try {
+        predicate = makeRecordPredicate(conditions);
+    } catch (const std::invalid_argument& ex) {
+        std::cout << "Помилка: " << ex.what() << std::endl;
+        return;
+    }
+
+    const std::size_t matched = countWhere(queue, predicate);
+    if (matched == 0) {
+        std::cout << "Жоден запис не відповідає умовам: " << describeConditions(conditions) << ".\n";
+        return;
+    }
+
+    const RecordField field = inputRecordField("Поле для оновлення");
+    const std::string newValue = getLineWithPrompt("Нове значення" + recordFieldValueHint(field) + ": ");
+
+    if (!getYesNoInput("Буде змінено записів: " + std::to_string(matched) + " (" + describeConditions(conditions) +
+                       "). Продовжити?")) {
+        std::cout << "Оновлення скасовано.\n";
+        return;
+    }
+
+    try {
+        const std::size_t updated = updateWhere(queue, predicate, field, newValue);
+        std::cout << "Оновлено записів: " << updated << ".\n";
+    } catch (const std::invalid_argument& ex) {
+        std::cout << "Помилка: " << ex.what() << std::endl;
+    }
+}
+
+void bulkDeleteRecords(Queue& queue) {
+    if (isEmpty(queue)) {
+        std::cout << "Черга порожня. Немає записів для видалення.\n";
+        return;
+    }
+
+    std::cout << "Масове видалення записів за умовою.\n";
+    const std::vector<RecordCondition> conditions = inputRecordConditions();
+    RecordPredicate predicate;
+    try {
+        predicate = makeRecordPredicate(conditions);
+    } catch (const std::invalid_argument& ex) {
+        std::cout << "Помилка: " << ex.what() << std::endl;
+        return;
+    }
+
+    const std::size_t matched = countWhere(queue, predicate);
+    if (matched == 0) {
+        std::cout << "Жоден запис не відповідає умовам: " << describeConditions(conditions) << ".\n";
+        return;
+    }
+    if (!getYesNoInput("Буде видалено записів: " + std::to_string(matched) + " (" + describeConditions(conditions) +
+                       "). Продовжити?")) {
+        std::cout << "Видалення скасовано.\n";
+        return;
+    }
+
+    const std::size_t deleted = deleteWhere(queue, predicate);
+    std::cout << "Видалено записів: " << deleted << ".\n";
+}
+
+void printPickupSchedule(const PickupPriorityView& pickupView) {
+    if (pickupView.empty()) {
+        std::cout << "Черга порожня. Немає запланованих вивезень.\n";
+        return;
+    }
+
+    const int count = getIntWithPrompt("Скільки наступних вивезень показати? ", 1);
+    const std::vector<const WasteNode*> schedule = pickupView.upcoming(static_cast<std::size_t>(count));
+    std::cout << "\n===== ГРАФІК ВИВЕЗЕНЬ (найраніша дата, потім найбільша кількість) =====\n";
+    for (std::size_t i = 0; i < schedule.size(); ++i) {
+        printSingleRecordDetails(schedule[i]->data, static_cast<int>(i + 1));
+    }
+}
+
+void dispatchNextPickup(PickupPriorityView& pickupView) {
+    if (pickupView.empty()) {
+        std::cout << "Черга порожня. Немає записів для вивезення.\n";
+        return;
+    }
+
+    std::cout << "Наступне вивезення за пріоритетом:\n";
+    printSingleRecordDetails(pickupView.top().data, -1);
+    if (getYesNoInput("Позначити як виконане і вилучити з черги?")) {
+        const WasteRecord dispatched = pickupView.popNext();
+        std::cout << "Вивезення для підприємства '" << dispatched.companyName << "' вилучено з черги.\n";
+    } else {
+        std::cout << "Вивезення не змінено.\n";
+    }
+}
+
+void promptAndSaveQueue(const Queue& queue) {
+    std::string filename = getLineWithPrompt("Введіть ім'я файлу для збереження (натисніть Enter для " + DEFAULT_FILENAME + "): ");
+    if (filename.empty()) {
+        filename = DEFAULT_FILENAME;
+    }
+    const bool compressed = getYesNoInput("Зберегти у стиснутому блочному форматі?");
+    const bool saved = compressed ? saveQueueToCompressedFile(queue, filename) : saveQueueToFile(queue, filename);
+    if (saved) {
+        std::cout << "Дані успішно збережено у " << (compressed ? "стиснутий " : "") << "файл: " << filename << std::endl;
+    }
+}
+
+void promptAndMergeFiles(Queue& queue) {
+    std::cout << "Введіть імена файлів для злиття, по одному в рядку (порожній рядок - завершити):\n";
+    std::vector<std::string> filenames;
+    while (true) {
+        const std::string filename = getLineWithPrompt("Файл " + std::to_string(filenames.size() + 1) + ": ");
+        if (filename.empty()) {
+            break;
+        }
+        filenames.push_back(filename);
+    }
+    if (filenames.empty()) {
+        std::cout << "Жодного файлу не вказано. Злиття скасовано.\n";
+        return;
+    }
+
+    MergeLoadStats stats;
+    if (!mergeQueueFromFiles(queue, filenames, stats)) {
+        std::cout << "Черга залишилась без змін." << std::endl;
+        return;
+    }
+    std::cout << "Опрацьовано файлів: " << stats.filesRead << ", прочитано записів: " << stats.recordsRead << "\n"
+              << "Додано до черги: " << stats.recordsAdded << ", пропущено дублікатів: " << stats.duplicatesSkipped << "\n";
+}
+
+void printTrendReport(const Queue& queue) {
+    if (isEmpty(queue)) {
+        std::cout << "Черга порожня. Немає даних для звіту.\n";
+        return;
+    }
+
+    const int periodInt = getIntWithPrompt("Період (1 = місяць, 2 = тиждень): ", 1, 2);
+    const TrendPeriod period = static_cast<TrendPeriod>(periodInt);
+    const std::string companyFilter = getLineWithPrompt("Введіть назву підприємства (натисніть Enter для всіх підприємств): ");
+
+    const TrendReport report = buildTrendReport(queue);
+    const std::vector<TrendRow>& rows = period == TrendPeriod::Month ? report.monthly : report.weekly;
+
+    // Підсумок за періодами по всіх видах відходів і станах; деталізація - у CSV.
+    std::map<std::int32_t, TrendRow> totals;
+    for (const TrendRow& row : rows) {
+        if (!companyFilter.empty() && row.companyName != companyFilter) {
+            continue;
+        }
+        auto inserted = totals.emplace(row.periodKey, TrendRow{ {}, {}, row.state, row.periodKey });
+        TrendRow& total = inserted.first->second;
+        total.totalQuantity += row.totalQuantity;
+        total.totalCost += row.totalCost;
+        total.matchedRecords += row.matchedRecords;
+    }
+
+    if (totals.empty()) {
+        std::cout << "Не знайдено записів для підприємства '" << companyFilter << "'.\n";
+    } else {
+        std::cout << "\n===== ДИНАМІКА ВИВЕЗЕНЬ (" << (period == TrendPeriod::Month ? "за місяцями" : "за тижнями")
+                  << (companyFilter.empty() ? "" : ", " + companyFilter) << ") =====\n"
+                  << std::fixed << std::setprecision(2);
+        for (const auto& entry : totals) {
+            std::cout << getTrendPeriodLabel(period, entry.first)
+                      << " | записів: " << entry.second.matchedRecords
+                      << " | кількість: " << entry.second.totalQuantity
+                      << " | вартість: " << entry.second.totalCost << " грн.\n";
+        }
+    }
+    if (report.skippedRecords > 0) {
+        std::cout << "Пропущено записів з некоректною датою: " << report.skippedRecords << "\n";
+    }
+
+    if (!getYesNoInput("Експортувати повний звіт (місяці й тижні за підприємством, видом відходу та станом) у CSV?")) {
+        return;
+    }
+    const std::string defaultFilename = "ilona_trends.csv";
+    std::string filename = getLineWithPrompt("Введіть ім'я файлу (натисніть Enter для " + defaultFilename + "): ");
+    if (filename.empty()) {
+        filename = defaultFilename;
+    }
+    if (writeTrendReportCsv(report, filename)) {
+        std::cout << "Звіт збережено у файл: " << filename << std::endl;
+    }
+}
+
+void showMetrics() {
+    printMetrics(std::cout);
+    if (!metricsEnabled() || !getYesNoInput("Зберегти метрики у файл?")) {
+        return;
+    }
+
+    const int format = getIntWithPrompt("Формат (1 = JSON, 2 = Prometheus): ", 1, 2);
+    const std::string defaultFilename = format == 1 ? "ilona_metrics.json" : "ilona_metrics.prom";
+    std::string filename = getLineWithPrompt("Введіть ім'я файлу (натисніть Enter для " + defaultFilename + "): ");
+    if (filename.empty()) {
+        filename = defaultFilename;
+    }
+
+    const bool saved = format == 1 ? writeMetricsJson(filename) : writeMetricsPrometheus(filename);
+    if (saved) {
+        std::cout << "Метрики збережено у файл: " << filename << std::endl;
+    } else {
+        std::cerr << "Помилка: не вдалося записати метрики у файл: " << filename << std::endl;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef ILONA_CONSOLE_IO_H
+#define ILONA_CONSOLE_IO_H
+
+#include "bulk_ops.h"
+#include "mapped_records.h"
+#include "merge_load.h"
+#include "pickup_priority.h"
+#include "report_cache.h"
+#include "search_index.h"
+#include "trend_report.h"
+#include "waste_queue.h"
+
+#include <limits>
+#include <string>
+
+extern const std::string DEFAULT_FILENAME;
+
+std::string getLineWithPrompt(const std::string& prompt);
+std::string getTextFieldWithPrompt(const std::string& prompt);
+int getIntWithPrompt(const std::string& prompt, int minVal = std::numeric_limits<int>::min(), int maxVal = std::numeric_limits<int>::max());
+double getDoubleWithPrompt(const std::string& prompt, double minVal = -std::numeric_limits<double>::max(), double maxVal = std::numeric_limits<double>::max());
+bool getYesNoInput(const std::string& prompt);
+int inputPhysicalState(const std::string& prompt = "Введіть агрегатний стан");
+std::string inputDate(const std::string& promptMessage);
+SortingDirection inputSoringDirection(const std::string& prompt);
+WasteRecord inputWasteRecord();
+// Зчитує назву; якщо точного збігу немає, пропонує схожі назви з індексу.
+std::string inputNameWithSuggestions(const std::string& prompt, const NameSearchIndex& index);
+
+void printSingleRecordDetails(const WasteRecord& record, int recordNumber = -1);
+void printQueue(const Queue& queue);
+
+void printCompaniesByWasteTypeAndDate(const Queue& queue, ReportCache& reportCache, const QueueSearchIndex& searchIndex);
+void calculateServiceCostByWasteTypeAndCompany(const Queue& queue, ReportCache& reportCache, const QueueSearchIndex& searchIndex);
+void findCompaniesByPhysicalState(const Queue& queue, ReportCache& reportCache);
+void calculateWasteCountByCompanyAndDateRange(const Queue& queue, ReportCache& reportCache, const QueueSearchIndex& searchIndex);
+// Ті самі звіти над файлом у лінивому режимі (без підказок назв: індексу пошуку ще немає).
+void printMappedFileRecords(MappedRecordFile& file);
+void printCompaniesByWasteTypeAndDate(MappedRecordFile& file);
+void calculateServiceCostByWasteTypeAndCompany(MappedRecordFile& file);
+void findCompaniesByPhysicalState(MappedRecordFile& file);
+void calculateWasteCountByCompanyAndDateRange(MappedRecordFile& file);
+void updateRecord(Queue& queue, const QueueSearchIndex& searchIndex);
+void bulkUpdateRecords(Queue& queue);
+void bulkDeleteRecords(Queue& queue);
+void printPickupSchedule(const PickupPriorityView& pickupView);
+void dispatchNextPickup(PickupPriorityView& pickupView);
+
+void promptAndSaveQueue(const Queue& queue);
+void promptAndMergeFiles(Queue& queue);
+void printTrendReport(const Queue& queue);
+void showMetrics();
+
+#endif
@@ -0,0 +1,37 @@
+#include "console_platform.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <clocale>
+#include <cstring>
+#include <iostream>
+#include <langinfo.h>
+
+namespace {
+
+bool isUtf8Codeset() {
+    const char* codeset = nl_langinfo(CODESET);
+    return codeset != nullptr && (std::strcmp(codeset, "UTF-8") == 0 || std::strcmp(codeset, "utf8") == 0);
+}
+
+} // namespace
+#endif
+
+void configureConsoleEncoding() {
+#ifdef _WIN32
+    SetConsoleCP(1251);
+    SetConsoleOutputCP(1251);
+#else
+    // Лише LC_CTYPE: LC_NUMERIC з локалі uk_UA змінив би десятковий роздільник для std::stod.
+    std::setlocale(LC_CTYPE, "");
+    if (!isUtf8Codeset()) {
+        std::setlocale(LC_CTYPE, "C.UTF-8");
+    }
+    if (!isUtf8Codeset()) {
+        const char* codeset = nl_langinfo(CODESET);
+        std::cerr << "Попередження: термінал використовує кодування " << (codeset ? codeset : "невідоме")
+                  << ", а не UTF-8. Кирилиця може відображатися некоректно.\n";
+    }
+#endif
+}
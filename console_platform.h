@@ -0,0 +1,8 @@
+#ifndef ILONA_CONSOLE_PLATFORM_H
+#define ILONA_CONSOLE_PLATFORM_H
+
+// Налаштовує кодування консолі для кирилиці:
+// Windows - кодова сторінка 1251, Linux та інші POSIX-системи - локаль середовища в UTF-8.
+void configureConsoleEncoding();
+
+#endif
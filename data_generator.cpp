@@ -0,0 +1,168 @@
+#include "data_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+
+namespace {
+
+// Власні перетворення замість std::*_distribution: ті залежать від реалізації
+// стандартної бібліотеки, а набір даних має бути однаковим на всіх платформах.
+std::uint64_t uniformIndex(std::mt19937_64& rng, const std::uint64_t bound) {
+    return rng() % bound;
+}
+
+double uniformUnit(std::mt19937_64& rng) {
+    return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+const char* const NAME_PREFIXES[] = {
+    "Еко", "Чисте", "Зелене", "Промислове", "Комунальне", "Регіональне", "Українське",
+    "Столичне", "Дніпровське", "Карпатське", "Подільське", "Слобожанське"
+};
+
+const char* const NAME_CORES[] = {
+    "Місто", "Довкілля", "Майбутнє", "Сервіс", "Утилізація", "Переробка",
+    "Технології", "Ресурс", "Транспорт", "Рішення"
+};
+
+const char* const LEGAL_FORMS[] = {
+    "ТОВ", "ПП", "ПАТ", "КП", "ДП"
+};
+
+const char* const CITIES[] = {
+    "Київ", "Львів", "Одеса", "Харків", "Дніпро", "Запоріжжя", "Вінниця", "Полтава",
+    "Чернігів", "Черкаси", "Житомир", "Івано-Франківськ", "Тернопіль", "Ужгород"
+};
+
+const char* const PHONE_CODES[] = {
+    "044", "032", "048", "057", "056", "061", "043", "053",
+    "046", "047", "041", "034", "035", "031"
+};
+
+const char* const STREETS[] = {
+    "Шевченка", "Франка", "Центральна", "Соборна", "Незалежності", "Грушевського",
+    "Промислова", "Заводська", "Садова", "Лесі Українки", "Богдана Хмельницького", "Вокзальна"
+};
+
+struct WasteTypeTemplate {
+    const char* name;
+    PhysicalState state;
+    double unitPrice;
+    double weight;
+};
+
+const WasteTypeTemplate WASTE_TYPES[] = {
+    { "Побутові відходи", PhysicalState::Solid, 4.5, 30.0 },
+    { "Будівельне сміття", PhysicalState::Solid, 5.2, 18.0 },
+    { "Інші тверді", PhysicalState::Solid, 3.8, 9.0 },
+    { "Металобрухт", PhysicalState::Solid, 2.1, 6.0 },
+    { "Макулатура", PhysicalState::Solid, 1.5, 6.0 },
+    { "Скло", PhysicalState::Solid, 2.4, 4.0 },
+    { "Пластик", PhysicalState::Solid, 3.1, 5.0 },
+    { "Органічні відходи", PhysicalState::Solid, 2.9, 4.0 },
+    { "Медичні відходи", PhysicalState::Solid, 28.0, 1.5 },
+    { "Відпрацьовані масла", PhysicalState::Liquid, 11.4, 4.0 },
+    { "Рідкі хім. відходи", PhysicalState::Liquid, 40.0, 2.0 },
+    { "Стічні води", PhysicalState::Liquid, 1.2, 5.0 },
+    { "Фарби та розчинники", PhysicalState::Liquid, 22.5, 1.5 },
+    { "Промислові гази", PhysicalState::Gas, 300.0, 0.8 },
+    { "Фреони", PhysicalState::Gas, 410.0, 0.2 }
+};
+
+template <typename T, std::size_t N>
+const T& pick(std::mt19937_64& rng, const T (&values)[N]) {
+    return values[uniformIndex(rng, N)];
+}
+
+} // namespace
+
+WasteDataGenerator::WasteDataGenerator(const std::uint64_t seed, const std::size_t companyCount) : rng(seed) {
+    companies.reserve(companyCount);
+    double cumulative = 0.0;
+    for (std::size_t i = 0; i < companyCount; ++i) {
+        const std::size_t city = uniformIndex(rng, std::size(CITIES));
+        char code[32];
+        std::snprintf(code, sizeof(code), "C%05zu", i + 1);
+        char phone[32];
+        std::snprintf(phone, sizeof(phone), "%s-%03d-%02d-%02d", PHONE_CODES[city],
+                      static_cast<int>(uniformIndex(rng, 900) + 100),
+                      static_cast<int>(uniformIndex(rng, 100)), static_cast<int>(uniformIndex(rng, 100)));
+
+        std::string name = std::string(pick(rng, LEGAL_FORMS)) + " «" + pick(rng, NAME_PREFIXES) + " "
+                           + pick(rng, NAME_CORES) + " " + CITIES[city] + "»";
+        // Однакові назви отримують номер, щоб підприємства були розрізнюваними.
+        name += " №" + std::to_string(i + 1);
+
+        std::string address = std::string("м. ") + CITIES[city] + ", вул. " + pick(rng, STREETS) + ", "
+                              + std::to_string(uniformIndex(rng, 200) + 1);
+
+        companies.push_back(Company{ code, std::move(name), std::move(address), phone });
+
+        // Розподіл Ципфа з показником 1.1
+        cumulative += 1.0 / std::pow(static_cast<double>(i + 1), 1.1);
+        companyCumulativeWeights.push_back(cumulative);
+    }
+
+    cumulative = 0.0;
+    for (std::size_t i = 0; i < std::size(WASTE_TYPES); ++i) {
+        char code[32];
+        std::snprintf(code, sizeof(code), "W%02zu", i + 1);
+        wasteTypes.push_back(WasteType{ code, WASTE_TYPES[i].name, WASTE_TYPES[i].state, WASTE_TYPES[i].unitPrice });
+        cumulative += WASTE_TYPES[i].weight;
+        wasteCumulativeWeights.push_back(cumulative);
+    }
+}
+
+std::size_t WasteDataGenerator::pickWeighted(const std::vector<double>& cumulativeWeights) {
+    const double target = uniformUnit(rng) * cumulativeWeights.back();
+    const auto it = std::upper_bound(cumulativeWeights.begin(), cumulativeWeights.end(), target);
+    return std::min<std::size_t>(it - cumulativeWeights.begin(), cumulativeWeights.size() - 1);
+}
+
+std::string WasteDataGenerator::randomDate() {
+    const int year = 2015 + static_cast<int>(uniformIndex(rng, 11));
+    const int month = 1 + static_cast<int>(uniformIndex(rng, 12));
+    int daysInMonth[] = { 31,28,31,30,31,30,31,31,30,31,30,31 };
+    if (isLeapYear(year)) {
+        daysInMonth[1] = 29;
+    }
+    const int day = 1 + static_cast<int>(uniformIndex(rng, daysInMonth[month - 1]));
+
+    // Із запасом на три довільні int (до 11 символів кожен), щоб snprintf ніколи не обрізав рядок.
+    char date[3 * 12];
+    std::snprintf(date, sizeof(date), "%02d:%02d:%04d", day, month, year);
+    return date;
+}
+
+WasteRecord WasteDataGenerator::next() {
+    const Company& company = companies[pickWeighted(companyCumulativeWeights)];
+    const WasteType& waste = wasteTypes[pickWeighted(wasteCumulativeWeights)];
+
+    // Більшість вивезень невеликі, але трапляються й великі партії.
+    const double skew = uniformUnit(rng);
+    const int quantity = 1 + static_cast<int>(skew * skew * skew * 999.0);
+    const double price = quantity * waste.unitPrice * (0.8 + 0.4 * uniformUnit(rng));
+    const double cost = std::max(0.01, std::round(price * 100.0) / 100.0);
+
+    return WasteRecord(company.code, company.name, company.address, company.phone,
+                       waste.code, waste.name, waste.state, randomDate(), quantity, cost);
+}
+
+std::vector<WasteRecord> WasteDataGenerator::generate(const std::size_t count) {
+    std::vector<WasteRecord> records;
+    records.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        records.push_back(next());
+    }
+    return records;
+}
+
+const std::string& WasteDataGenerator::mostFrequentCompanyName() const {
+    return companies.front().name;
+}
+
+const std::string& WasteDataGenerator::mostFrequentWasteName() const {
+    return wasteTypes.front().name;
+}
@@ -0,0 +1,52 @@
+#ifndef ILONA_DATA_GENERATOR_H
+#define ILONA_DATA_GENERATOR_H
+
+#include "waste_queue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Детермінований генератор реалістичних записів для бенчмарків.
+// Підприємства обираються за розподілом Ципфа (кілька великих клієнтів
+// дають більшість записів), агрегатний стан залежить від виду відходу,
+// дати рівномірно покривають 2015-2025 роки.
+class WasteDataGenerator {
+public:
+    explicit WasteDataGenerator(std::uint64_t seed = 20231015, std::size_t companyCount = 2000);
+
+    WasteRecord next();
+    std::vector<WasteRecord> generate(std::size_t count);
+
+    // Параметри, для яких звіти гарантовано знаходять записи.
+    const std::string& mostFrequentCompanyName() const;
+    const std::string& mostFrequentWasteName() const;
+
+private:
+    struct Company {
+        std::string code;
+        std::string name;
+        std::string address;
+        std::string phone;
+    };
+
+    struct WasteType {
+        std::string code;
+        std::string name;
+        PhysicalState state;
+        double unitPrice;
+    };
+
+    std::mt19937_64 rng;
+    std::vector<Company> companies;
+    std::vector<double> companyCumulativeWeights;
+    std::vector<WasteType> wasteTypes;
+    std::vector<double> wasteCumulativeWeights;
+
+    std::size_t pickWeighted(const std::vector<double>& cumulativeWeights);
+    std::string randomDate();
+};
+
+#endif
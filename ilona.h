@@ -0,0 +1,18 @@
+#ifndef ILONA_H
+#define ILONA_H
+
+// Публічний API бібліотеки ilona_core без інтерактивного вводу: усі її заголовки.
+
+#include "bulk_ops.h"
+#include "compression.h"
+#include "mapped_records.h"
+#include "merge_load.h"
+#include "metrics.h"
+#include "pickup_priority.h"
+#include "report_cache.h"
+#include "reports.h"
+#include "search_index.h"
+#include "trend_report.h"
+#include "waste_queue.h"
+
+#endif
@@ -0,0 +1,377 @@
+#include "data_generator.h"
+#include "protocol.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Генератор навантаження для ilona_server:
+// ilona_loadgen [--port N | --unix ШЛЯХ] [--connections C] [--requests N] [--pipeline D]
+//               [--preload N] [--seed N]
+// Кожне з'єднання працює у своєму потоці й тримає до D запитів у польоті.
+// Суміш: 45% enqueue, 5% update, 10% dequeue, 2% вивезення за пріоритетом, 8% peek/size, 30% звітів.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct LoadOptions {
+    int port = 7878;
+    std::string unixPath;
+    std::size_t connections = 4;
+    std::size_t requestsPerConnection = 20000;
+    std::size_t pipelineDepth = 16;
+    std::size_t preloadRecords = 10000;
+    std::uint64_t seed = 20231015;
+};
+
+struct ConnectionStats {
+    std::vector<double> latenciesNs;
+    std::size_t okResponses = 0;
+    std::size_t notFoundResponses = 0;
+    std::size_t failedResponses = 0;
+    std::string error;
+};
+
+int connectToServer(const LoadOptions& options) {
+    int fd;
+    if (options.unixPath.empty()) {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd == -1) {
+            return -1;
+        }
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<std::uint16_t>(options.port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1) {
+            close(fd);
+            return -1;
+        }
+        const int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    } else {
+        sockaddr_un address{};
+        if (options.unixPath.size() >= sizeof(address.sun_path)) {
+            return -1;
+        }
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd == -1) {
+            return -1;
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, options.unixPath.c_str(), options.unixPath.size() + 1);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1) {
+            close(fd);
+            return -1;
+        }
+    }
+    return fd;
+}
+
+bool sendAll(const int fd, const std::string& data) {
+    std::size_t offset = 0;
+    while (offset < data.size()) {
+        const ssize_t sent = send(fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            if (sent == -1 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        offset += static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+// Буферизоване читання відповідей: повертає статус чергового кадру.
+class ResponseReader {
+public:
+    explicit ResponseReader(const int fd) : fd(fd) {}
+
+    bool nextStatus(ResponseStatus& status) {
+        while (true) {
+            const char* payload = nullptr;
+            std::size_t payloadSize = 0;
+            if (nextFrame(buffer, offset, payload, payloadSize)) {
+                if (payloadSize == 0) {
+                    return false;
+                }
+                status = static_cast<ResponseStatus>(payload[0]);
+                return true;
+            }
+            buffer.erase(0, offset);
+            offset = 0;
+            char chunk[64 * 1024];
+            const ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                if (received == -1 && errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            buffer.append(chunk, static_cast<std::size_t>(received));
+        }
+    }
+
+private:
+    int fd;
+    std::string buffer;
+    std::size_t offset = 0;
+};
+
+void appendStringRequest(std::string& out, const RequestType type, const std::vector<std::string>& arguments) {
+    const std::size_t frameStart = beginFrame(out);
+    ProtocolWriter writer(out);
+    writer.putU8(static_cast<std::uint8_t>(type));
+    for (const std::string& argument : arguments) {
+        writer.putString(argument);
+    }
+    finishFrame(out, frameStart);
+}
+
+void appendEnqueueRequest(std::string& out, const WasteRecord& record) {
+    const std::size_t frameStart = beginFrame(out);
+    ProtocolWriter writer(out);
+    writer.putU8(static_cast<std::uint8_t>(RequestType::Enqueue));
+    writer.putRecord(record);
+    finishFrame(out, frameStart);
+}
+
+// Замінює matchIndex-й запис підприємства; назву підприємства новий запис зберігає,
+// щоб звіти за ним і далі мали що рахувати.
+void appendUpdateRequest(std::string& out, const std::string& companyName, const std::uint32_t matchIndex,
+                         WasteRecord record) {
+    record.companyName = companyName;
+    const std::size_t frameStart = beginFrame(out);
+    ProtocolWriter writer(out);
+    writer.putU8(static_cast<std::uint8_t>(RequestType::Update));
+    writer.putString(companyName);
+    writer.putU32(matchIndex);
+    writer.putRecord(record);
+    finishFrame(out, frameStart);
+}
+
+class RequestMix {
+public:
+    explicit RequestMix(const std::uint64_t seed) : generator(seed), rng(seed ^ 0x9E3779B97F4A7C15ULL) {}
+
+    void appendNext(std::string& out) {
+        const unsigned roll = static_cast<unsigned>(rng() % 100);
+        if (roll < 45) {
+            appendEnqueueRequest(out, generator.next());
+        } else if (roll < 50) {
+            appendUpdateRequest(out, generator.mostFrequentCompanyName(), static_cast<std::uint32_t>(rng() % 4),
+                                generator.next());
+        } else if (roll < 60) {
+            appendStringRequest(out, RequestType::Dequeue, {});
+        } else if (roll < 63) {
+            appendStringRequest(out, RequestType::Peek, {});
+        } else if (roll < 65) {
+            appendStringRequest(out, RequestType::DispatchNextPickup, {});
+        } else if (roll < 70) {
+            appendStringRequest(out, RequestType::Size, {});
+        } else if (roll < 78) {
+            appendStringRequest(out, RequestType::CompaniesByWasteAndDate,
+                                { generator.mostFrequentWasteName(), generator.next().removalDate });
+        } else if (roll < 86) {
+            appendStringRequest(out, RequestType::CostByCompanyAndWaste,
+                                { generator.mostFrequentCompanyName(), generator.mostFrequentWasteName() });
+        } else if (roll < 93) {
+            const std::size_t frameStart = beginFrame(out);
+            ProtocolWriter writer(out);
+            writer.putU8(static_cast<std::uint8_t>(RequestType::CompaniesByPhysicalState));
+            writer.putU8(static_cast<std::uint8_t>(1 + rng() % 3));
+            finishFrame(out, frameStart);
+        } else {
+            appendStringRequest(out, RequestType::QuantityByCompanyAndDateRange,
+                                { generator.mostFrequentCompanyName(), "01:01:2018", "31:12:2022" });
+        }
+    }
+
+private:
+    WasteDataGenerator generator;
+    std::mt19937_64 rng;
+};
+
+bool preload(const LoadOptions& options) {
+    const int fd = connectToServer(options);
+    if (fd == -1) {
+        return false;
+    }
+    WasteDataGenerator generator(options.seed);
+    ResponseReader reader(fd);
+    constexpr std::size_t BATCH = 512;
+    bool ok = true;
+    for (std::size_t sent = 0; ok && sent < options.preloadRecords; sent += BATCH) {
+        const std::size_t batch = std::min(BATCH, options.preloadRecords - sent);
+        std::string out;
+        for (std::size_t i = 0; i < batch; ++i) {
+            appendEnqueueRequest(out, generator.next());
+        }
+        ok = sendAll(fd, out);
+        ResponseStatus status;
+        for (std::size_t i = 0; ok && i < batch; ++i) {
+            ok = reader.nextStatus(status) && status == ResponseStatus::Ok;
+        }
+    }
+    close(fd);
+    return ok;
+}
+
+void runConnection(const LoadOptions& options, const std::size_t index, std::atomic<bool>& startFlag,
+                   ConnectionStats& stats) {
+    const int fd = connectToServer(options);
+    if (fd == -1) {
+        stats.error = std::string("не вдалося підключитися: ") + std::strerror(errno);
+        return;
+    }
+    RequestMix mix(options.seed + 1 + index);
+    ResponseReader reader(fd);
+    std::deque<Clock::time_point> inFlight;
+    stats.latenciesNs.reserve(options.requestsPerConnection);
+
+    while (!startFlag.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    std::size_t issued = 0;
+    std::size_t completed = 0;
+    std::string out;
+    while (completed < options.requestsPerConnection) {
+        // Доповнюємо вікно до глибини конвеєра одним записом у сокет.
+        out.clear();
+        const Clock::time_point sendTime = Clock::now();
+        while (issued < options.requestsPerConnection && inFlight.size() < options.pipelineDepth) {
+            mix.appendNext(out);
+            inFlight.push_back(sendTime);
+            ++issued;
+        }
+        if (!out.empty() && !sendAll(fd, out)) {
+            stats.error = "з'єднання розірвано під час надсилання";
+            break;
+        }
+
+        ResponseStatus status;
+        if (!reader.nextStatus(status)) {
+            stats.error = "з'єднання розірвано під час читання";
+            break;
+        }
+        const Clock::time_point receiveTime = Clock::now();
+        stats.latenciesNs.push_back(static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(receiveTime - inFlight.front()).count()));
+        inFlight.pop_front();
+        ++completed;
+
+        if (status == ResponseStatus::Ok) {
+            ++stats.okResponses;
+        } else if (status == ResponseStatus::NotFound) {
+            ++stats.notFoundResponses;
+        } else {
+            ++stats.failedResponses;
+        }
+    }
+    close(fd);
+}
+
+double percentile(const std::vector<double>& sorted, const double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const std::size_t rank = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1));
+    return sorted[rank];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LoadOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        try {
+            if (argument == "--port" && i + 1 < argc) {
+                options.port = std::stoi(argv[++i]);
+            } else if (argument == "--unix" && i + 1 < argc) {
+                options.unixPath = argv[++i];
+            } else if (argument == "--connections" && i + 1 < argc) {
+                options.connections = std::max<std::size_t>(1, std::stoull(argv[++i]));
+            } else if (argument == "--requests" && i + 1 < argc) {
+                options.requestsPerConnection = std::stoull(argv[++i]);
+            } else if (argument == "--pipeline" && i + 1 < argc) {
+                options.pipelineDepth = std::max<std::size_t>(1, std::stoull(argv[++i]));
+            } else if (argument == "--preload" && i + 1 < argc) {
+                options.preloadRecords = std::stoull(argv[++i]);
+            } else if (argument == "--seed" && i + 1 < argc) {
+                options.seed = std::stoull(argv[++i]);
+            } else {
+                throw std::invalid_argument(argument);
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Використання: " << argv[0]
+                      << " [--port N | --unix ШЛЯХ] [--connections C] [--requests N] [--pipeline D]"
+                         " [--preload N] [--seed N]\n";
+            return 1;
+        }
+    }
+
+    if (options.preloadRecords > 0 && !preload(options)) {
+        std::cerr << "Не вдалося попередньо заповнити чергу сервера.\n";
+        return 1;
+    }
+
+    std::vector<ConnectionStats> stats(options.connections);
+    std::vector<std::thread> workers;
+    std::atomic<bool> startFlag{false};
+    for (std::size_t i = 0; i < options.connections; ++i) {
+        workers.emplace_back(runConnection, std::cref(options), i, std::ref(startFlag), std::ref(stats[i]));
+    }
+    const Clock::time_point start = Clock::now();
+    startFlag.store(true, std::memory_order_release);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> latencies;
+    std::size_t ok = 0;
+    std::size_t notFound = 0;
+    std::size_t failed = 0;
+    bool anyError = false;
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        latencies.insert(latencies.end(), stats[i].latenciesNs.begin(), stats[i].latenciesNs.end());
+        ok += stats[i].okResponses;
+        notFound += stats[i].notFoundResponses;
+        failed += stats[i].failedResponses;
+        if (!stats[i].error.empty()) {
+            std::cerr << "З'єднання " << i << ": " << stats[i].error << "\n";
+            anyError = true;
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "З'єднань: " << options.connections << ", глибина конвеєра: " << options.pipelineDepth << "\n"
+              << "Запитів: " << latencies.size() << " за " << seconds << " с ("
+              << (seconds > 0 ? static_cast<double>(latencies.size()) / seconds : 0.0) << " запитів/с)\n"
+              << "Відповіді: успішно " << ok << ", не знайдено " << notFound << ", помилок " << failed << "\n"
+              << "Затримка: p50 " << percentile(latencies, 0.50) / 1e3 << " мкс, p99 "
+              << percentile(latencies, 0.99) / 1e3 << " мкс, макс "
+              << (latencies.empty() ? 0.0 : latencies.back() / 1e3) << " мкс\n";
+
+    return anyError || failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,462 @@
+#include "mapped_records.h"
+
+#include "compression.h"
+#include "metrics.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Роздільник записів формату saveQueueToFile.
+constexpr std::string_view RECORD_SEPARATOR_LINE = "---END_RECORD---";
+constexpr int RECORD_FIELD_COUNT = 10;
+// Менші шматки не виправдовують запуску окремих потоків для побудови індексу.
+constexpr std::size_t MIN_INDEX_CHUNK_SIZE = 4 * 1024 * 1024;
+constexpr std::size_t DECODE_CHUNK_SIZE = 16 * 1024;
+
+// Початок першого запису, що починається не раніше position: позиція одразу після
+// рядка-роздільника. Якщо такого немає - кінець тексту.
+std::size_t recordBoundaryAtOrAfter(const std::string_view text, const std::size_t position) {
+    const std::string pattern = "\n" + std::string(RECORD_SEPARATOR_LINE);
+    std::size_t searchFrom = position == 0 ? 0 : position - 1;
+    while (true) {
+        const std::size_t found = text.find(pattern, searchFrom);
+        if (found == std::string_view::npos) {
+            return text.size();
+        }
+        const std::size_t lineEnd = found + pattern.size();
+        if (lineEnd == text.size()) {
+            return text.size();
+        }
+        if (text[lineEnd] == '\n') {
+            return lineEnd + 1;
+        }
+        searchFrom = found + 1;
+    }
+}
+
+// Пропускає провідні пробіли та знак "+", як std::stoi і std::stod.
+std::string_view trimNumberPrefix(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+        text.remove_prefix(1);
+    }
+    if (text.size() > 1 && text.front() == '+' && text[1] != '-') {
+        text.remove_prefix(1);
+    }
+    return text;
+}
+
+template <typename T>
+bool parseNumber(std::string_view text, T& value) {
+    text = trimNumberPrefix(text);
+    const std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr != text.data();
+}
+
+// Ті самі правила для числових полів, що й у parseRecordStream; спільні для стовпців
+// і для розбору окремого запису.
+bool parseState(const std::string_view text, PhysicalState& state) {
+    int stateInt = 0;
+    if (!parseNumber(text, stateInt) || !isValidPhysicalState(stateInt)) {
+        return false;
+    }
+    state = static_cast<PhysicalState>(stateInt);
+    return true;
+}
+
+bool parseDateKey(const std::string_view text, std::int32_t& key) {
+    if (!isValidDate(text)) {
+        return false;
+    }
+    key = dateSortKey(text);
+    return true;
+}
+
+// Усі рядки запису за один прохід замість окремого пошуку кожного поля.
+void splitRecordLines(const char* line, const char* end, std::string_view (&lines)[RECORD_FIELD_COUNT]) {
+    for (std::string_view& text : lines) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+        text = std::string_view(line, static_cast<std::size_t>(lineEnd - line));
+        line = lineEnd + 1;
+    }
+}
+
+std::string_view recordLine(const std::string_view (&lines)[RECORD_FIELD_COUNT], const RecordField recordField) {
+    return lines[static_cast<int>(recordField) - 1];
+}
+
+// Ті самі перевірки числових полів, що й у parseRecordStream, без збереження значень.
+bool hasValidNumericFields(const std::string_view (&lines)[RECORD_FIELD_COUNT]) {
+    PhysicalState state;
+    std::int32_t dateKey;
+    int quantity;
+    double cost;
+    return parseState(recordLine(lines, RecordField::State), state) &&
+        parseDateKey(recordLine(lines, RecordField::RemovalDate), dateKey) &&
+        parseNumber(recordLine(lines, RecordField::Quantity), quantity) &&
+        parseNumber(recordLine(lines, RecordField::Cost), cost);
+}
+
+// Індексує записи в [begin, end); begin має бути початком запису. Прохід і так
+// читає кожен рядок, тож тут же перевіряються числові поля повних записів: звітам
+// не треба розбирати стовпці, яких вони не використовують, лише заради ознаки коректності.
+void indexRange(const std::string_view text, const std::size_t begin, const std::size_t end,
+                std::vector<std::uint64_t>& offsets, std::vector<unsigned char>& valid, std::size_t& incomplete) {
+    std::size_t position = begin;
+    std::size_t recordStart = begin;
+    std::string_view recordLines[RECORD_FIELD_COUNT];
+    int lines = 0;
+    while (position < end) {
+        std::size_t lineEnd = text.find('\n', position);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = text.size();
+        }
+        const std::string_view line = text.substr(position, lineEnd - position);
+        if (line == RECORD_SEPARATOR_LINE) {
+            if (lines == RECORD_FIELD_COUNT) {
+                offsets.push_back(recordStart);
+                valid.push_back(hasValidNumericFields(recordLines) ? 1 : 0);
+            } else {
+                ++incomplete;
+            }
+            lines = 0;
+            recordStart = lineEnd + 1;
+        } else {
+            if (lines < RECORD_FIELD_COUNT) {
+                recordLines[lines] = line;
+            }
+            ++lines;
+        }
+        position = lineEnd + 1;
+    }
+    if (lines > 0) {
+        ++incomplete;
+    }
+}
+
+WasteRecord makeRecord(const std::string_view (&lines)[RECORD_FIELD_COUNT], const PhysicalState state,
+                       const int quantity, const double cost) {
+    auto text = [&lines](const RecordField recordField) {
+        return std::string(recordLine(lines, recordField));
+    };
+    return WasteRecord(text(RecordField::CompanyCode), text(RecordField::CompanyName), text(RecordField::Address),
+                       text(RecordField::Phone), text(RecordField::WasteCode), text(RecordField::WasteName),
+                       state, text(RecordField::RemovalDate), quantity, cost);
+}
+
+// Для кожного потоку - власний частковий результат без синхронізації.
+template <typename Partial, typename Visit>
+std::vector<Partial> scanRecords(const std::size_t count, Visit&& visit) {
+    const std::size_t threadCount = std::max<std::size_t>(1, std::min(workerThreadCount(), count));
+    const std::size_t chunkSize = (count + threadCount - 1) / threadCount;
+    std::vector<Partial> partials(threadCount);
+    parallelFor(count, chunkSize, [&](const std::size_t begin, const std::size_t end) {
+        Partial& partial = partials[begin / chunkSize];
+        for (std::size_t i = begin; i < end; ++i) {
+            visit(partial, i);
+        }
+    });
+    return partials;
+}
+
+std::set<std::string> mergeCompanySets(const std::vector<std::unordered_set<std::string_view>>& partials) {
+    std::set<std::string> companies;
+    for (const std::unordered_set<std::string_view>& partial : partials) {
+        for (const std::string_view companyName : partial) {
+            companies.emplace(companyName);
+        }
+    }
+    return companies;
+}
+
+} // namespace
+
+MappedRecordFile::MappedRecordFile(const std::string& filename) : path(filename) {
+    if (isBlockContainerFile(filename)) {
+        throw std::runtime_error("лінивий режим підтримує лише текстовий формат, а файл у блочному стиснутому форматі");
+    }
+#ifdef _WIN32
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("не вдалося відкрити файл");
+    }
+    std::ostringstream content;
+    content << in.rdbuf();
+    buffer = content.str();
+    data = buffer.data();
+    size = buffer.size();
+#else
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error(std::string("не вдалося відкрити файл: ") + std::strerror(errno));
+    }
+    struct stat status{};
+    if (fstat(fd, &status) == -1) {
+        const int error = errno;
+        close(fd);
+        throw std::runtime_error(std::string("не вдалося визначити розмір файлу: ") + std::strerror(error));
+    }
+    size = static_cast<std::size_t>(status.st_size);
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            const int error = errno;
+            close(fd);
+            throw std::runtime_error(std::string("не вдалося відобразити файл у пам'ять: ") + std::strerror(error));
+        }
+        data = static_cast<const char*>(mapping);
+    }
+    // Відображення лишається дійсним і після закриття дескриптора.
+    close(fd);
+#endif
+}
+
+MappedRecordFile::~MappedRecordFile() {
+#ifndef _WIN32
+    if (data != nullptr) {
+        munmap(const_cast<char*>(data), size);
+    }
+#endif
+}
+
+std::size_t MappedRecordFile::recordCount() {
+    ensureIndexed();
+    return recordOffsets.size();
+}
+
+std::size_t MappedRecordFile::skippedRecords() {
+    ensureIndexed();
+    return incompleteRecords;
+}
+
+void MappedRecordFile::ensureIndexed() {
+    if (indexed) {
+        return;
+    }
+    ILONA_TIME_OPERATION(MetricOperation::IndexMappedFile);
+    ILONA_COUNT(MetricCounter::BytesRead, size);
+    const std::string_view text(data, size);
+
+    // Шматки вирівнюються на межі записів, тож кожен індексується незалежно.
+    const std::size_t chunkCount = std::max<std::size_t>(1, std::min(workerThreadCount(), size / MIN_INDEX_CHUNK_SIZE));
+    std::vector<std::size_t> bounds(chunkCount + 1, size);
+    bounds[0] = 0;
+    for (std::size_t chunk = 1; chunk < chunkCount; ++chunk) {
+        bounds[chunk] = std::max(bounds[chunk - 1], recordBoundaryAtOrAfter(text, size / chunkCount * chunk));
+    }
+
+    std::vector<std::vector<std::uint64_t>> parts(chunkCount);
+    std::vector<std::vector<unsigned char>> validParts(chunkCount);
+    std::vector<std::size_t> incomplete(chunkCount, 0);
+    parallelFor(chunkCount, 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t chunk = begin; chunk < end; ++chunk) {
+            indexRange(text, bounds[chunk], bounds[chunk + 1], parts[chunk], validParts[chunk], incomplete[chunk]);
+        }
+    });
+
+    std::size_t total = 0;
+    for (const std::vector<std::uint64_t>& part : parts) {
+        total += part.size();
+    }
+    recordOffsets.reserve(total);
+    recordValid.reserve(total);
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        recordOffsets.insert(recordOffsets.end(), parts[chunk].begin(), parts[chunk].end());
+        recordValid.insert(recordValid.end(), validParts[chunk].begin(), validParts[chunk].end());
+        incompleteRecords += incomplete[chunk];
+    }
+    indexed = true;
+}
+
+std::string_view MappedRecordFile::field(const std::size_t recordIndex, const RecordField recordField) {
+    ensureIndexed();
+    const char* end = data + size;
+    const char* line = data + recordOffsets[recordIndex];
+    for (int skipped = 1; skipped < static_cast<int>(recordField); ++skipped) {
+        line = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(end - line))) + 1;
+    }
+    // Після останнього поля завжди йде рядок-роздільник, тож кінець рядка існує.
+    const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+    return std::string_view(line, static_cast<std::size_t>(lineEnd - line));
+}
+
+template <typename T, typename Parse>
+const MappedRecordFile::Column<T>& MappedRecordFile::decodeColumn(Column<T>& column, const RecordField recordField,
+                                                                  Parse&& parse) {
+    ensureIndexed();
+    if (column.valid.size() == recordOffsets.size()) {
+        return column;
+    }
+    const std::size_t count = recordOffsets.size();
+    column.values.assign(count, T{});
+    column.valid.assign(count, 0);
+    parallelFor(count, DECODE_CHUNK_SIZE, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            column.valid[i] = parse(field(i, recordField), column.values[i]) ? 1 : 0;
+        }
+    });
+    return column;
+}
+
+const MappedRecordFile::Column<PhysicalState>& MappedRecordFile::states() {
+    return decodeColumn(stateColumn, RecordField::State, parseState);
+}
+
+const MappedRecordFile::Column<std::int32_t>& MappedRecordFile::dateKeys() {
+    return decodeColumn(dateKeyColumn, RecordField::RemovalDate, parseDateKey);
+}
+
+const MappedRecordFile::Column<int>& MappedRecordFile::quantities() {
+    return decodeColumn(quantityColumn, RecordField::Quantity, parseNumber<int>);
+}
+
+const MappedRecordFile::Column<double>& MappedRecordFile::costs() {
+    return decodeColumn(costColumn, RecordField::Cost, parseNumber<double>);
+}
+
+const std::vector<unsigned char>& MappedRecordFile::validRecords() {
+    ensureIndexed();
+    return recordValid;
+}
+
+bool MappedRecordFile::isValidRecord(const std::size_t recordIndex) {
+    return validRecords()[recordIndex] != 0;
+}
+
+WasteRecord MappedRecordFile::record(const std::size_t recordIndex) {
+    if (recordIndex >= recordCount()) {
+        throw std::out_of_range("Номер запису поза межами файлу");
+    }
+    std::string_view lines[RECORD_FIELD_COUNT];
+    splitRecordLines(data + recordOffsets[recordIndex], data + size, lines);
+    PhysicalState state;
+    std::int32_t dateKey;
+    int quantity;
+    double cost;
+    if (!parseState(recordLine(lines, RecordField::State), state) ||
+        !parseDateKey(recordLine(lines, RecordField::RemovalDate), dateKey) ||
+        !parseNumber(recordLine(lines, RecordField::Quantity), quantity) ||
+        !parseNumber(recordLine(lines, RecordField::Cost), cost)) {
+        throw std::invalid_argument("Запис #" + std::to_string(recordIndex + 1) + " у файлі некоректний");
+    }
+    return makeRecord(lines, state, quantity, cost);
+}
+
+void MappedRecordFile::materialize(Queue& queue) {
+    ILONA_TIME_OPERATION(MetricOperation::LoadFile);
+    const std::size_t count = recordCount();
+    // Стовпці розбираються паралельно до послідовного заповнення черги.
+    const Column<PhysicalState>& stateValues = states();
+    const Column<int>& quantityValues = quantities();
+    const Column<double>& costValues = costs();
+
+    std::size_t invalidRecords = 0;
+    clearQueue(queue);
+    std::string_view lines[RECORD_FIELD_COUNT];
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!recordValid[i]) {
+            ++invalidRecords;
+            continue;
+        }
+        splitRecordLines(data + recordOffsets[i], data + size, lines);
+        enqueue(queue, makeRecord(lines, stateValues.values[i], quantityValues.values[i], costValues.values[i]));
+    }
+    ILONA_COUNT(MetricCounter::RecordsLoaded, count - invalidRecords);
+    ILONA_COUNT(MetricCounter::ParseErrorsSkipped, invalidRecords + incompleteRecords);
+    if (invalidRecords + incompleteRecords > 0) {
+        std::cerr << "Попередження: у файлі " << path << " пропущено некоректних записів: "
+                  << invalidRecords + incompleteRecords << "\n";
+    }
+}
+
+std::set<std::string> companiesByWasteAndDate(MappedRecordFile& file, const std::string& wasteName,
+                                              const std::string& removalDate) {
+    ILONA_TIME_OPERATION(MetricOperation::ReportCompaniesByWasteAndDate);
+    const std::vector<unsigned char>& valid = file.validRecords();
+    const auto partials = scanRecords<std::unordered_set<std::string_view>>(file.recordCount(),
+        [&](std::unordered_set<std::string_view>& found, const std::size_t i) {
+            if (valid[i] && file.field(i, RecordField::WasteName) == wasteName &&
+                file.field(i, RecordField::RemovalDate) == removalDate) {
+                found.insert(file.field(i, RecordField::CompanyName));
+            }
+        });
+    return mergeCompanySets(partials);
+}
+
+CostReport costByCompanyAndWaste(MappedRecordFile& file, const std::string& companyName, const std::string& wasteName) {
+    ILONA_TIME_OPERATION(MetricOperation::ReportServiceCost);
+    const std::vector<unsigned char>& valid = file.validRecords();
+    const MappedRecordFile::Column<double>& costs = file.costs();
+    const auto partials = scanRecords<CostReport>(file.recordCount(), [&](CostReport& report, const std::size_t i) {
+        if (valid[i] && file.field(i, RecordField::CompanyName) == companyName &&
+            file.field(i, RecordField::WasteName) == wasteName) {
+            report.totalCost += costs.values[i];
+            ++report.matchedRecords;
+        }
+    });
+    CostReport report;
+    for (const CostReport& partial : partials) {
+        report.totalCost += partial.totalCost;
+        report.matchedRecords += partial.matchedRecords;
+    }
+    return report;
+}
+
+std::set<std::string> companiesByPhysicalState(MappedRecordFile& file, const PhysicalState state) {
+    ILONA_TIME_OPERATION(MetricOperation::ReportCompaniesByPhysicalState);
+    const std::vector<unsigned char>& valid = file.validRecords();
+    const MappedRecordFile::Column<PhysicalState>& states = file.states();
+    const auto partials = scanRecords<std::unordered_set<std::string_view>>(file.recordCount(),
+        [&](std::unordered_set<std::string_view>& found, const std::size_t i) {
+            if (valid[i] && states.values[i] == state) {
+                found.insert(file.field(i, RecordField::CompanyName));
+            }
+        });
+    return mergeCompanySets(partials);
+}
+
+QuantityReport quantityByCompanyAndDateRange(MappedRecordFile& file, const std::string& companyName,
+                                             const std::string& startDate, const std::string& endDate) {
+    const std::string comparableStartDate = convertDateToComparableFormat(startDate);
+    const std::string comparableEndDate = convertDateToComparableFormat(endDate);
+    if (comparableStartDate > comparableEndDate) {
+        throw std::invalid_argument("початкова дата (" + startDate + ") не може бути пізніше кінцевої дати (" + endDate + ").");
+    }
+    const std::int32_t startKey = dateSortKey(startDate);
+    const std::int32_t endKey = dateSortKey(endDate);
+
+    ILONA_TIME_OPERATION(MetricOperation::ReportWasteCountByDateRange);
+    const std::vector<unsigned char>& valid = file.validRecords();
+    const MappedRecordFile::Column<std::int32_t>& dateKeys = file.dateKeys();
+    const MappedRecordFile::Column<int>& quantities = file.quantities();
+    const auto partials = scanRecords<QuantityReport>(file.recordCount(), [&](QuantityReport& report, const std::size_t i) {
+        if (valid[i] && dateKeys.values[i] >= startKey && dateKeys.values[i] <= endKey &&
+            file.field(i, RecordField::CompanyName) == companyName) {
+            report.totalQuantity += quantities.values[i];
+            ++report.matchedRecords;
+        }
+    });
+    QuantityReport report;
+    for (const QuantityReport& partial : partials) {
+        report.totalQuantity += partial.totalQuantity;
+        report.matchedRecords += partial.matchedRecords;
+    }
+    return report;
+}
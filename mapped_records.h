@@ -0,0 +1,93 @@
+#ifndef ILONA_MAPPED_RECORDS_H
+#define ILONA_MAPPED_RECORDS_H
+
+#include "bulk_ops.h"
+#include "reports.h"
+#include "waste_queue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Текстовий файл даних (формат saveQueueToFile), відображений у пам'ять, з лінивим розбором.
+// Відкриття лише відображає файл; індекс зміщень записів і ознака коректності кожного
+// запису будуються одним паралельним проходом при першому зверненні. Рядкові поля
+// читаються прямо з відображення, числові (агрегатний стан, дата, кількість, вартість)
+// розбираються стовпцем при першому зверненні і кешуються, тож звіт розбирає лише ті
+// стовпці, що йому потрібні.
+// Файл не повинен змінюватися, поки об'єкт існує.
+class MappedRecordFile {
+public:
+    // Значення поля, яке не вдалося розібрати, позначається в valid нулем.
+    template <typename T>
+    struct Column {
+        std::vector<T> values;
+        std::vector<unsigned char> valid;
+    };
+
+    // Кидає std::runtime_error, якщо файл не вдалося відкрити або він у блочному стиснутому форматі.
+    explicit MappedRecordFile(const std::string& filename);
+    ~MappedRecordFile();
+
+    MappedRecordFile(const MappedRecordFile&) = delete;
+    MappedRecordFile& operator=(const MappedRecordFile&) = delete;
+
+    const std::string& filename() const { return path; }
+    std::size_t recordCount();
+    // Неповні записи, пропущені під час побудови індексу.
+    std::size_t skippedRecords();
+
+    // Сирий текст поля; дійсний, доки існує об'єкт.
+    std::string_view field(std::size_t recordIndex, RecordField recordField);
+
+    const Column<PhysicalState>& states();
+    // Ключ РРРРММДД (dateSortKey) для дат, що проходять isValidDate.
+    const Column<std::int32_t>& dateKeys();
+    const Column<int>& quantities();
+    const Column<double>& costs();
+
+    // 1 для записів, що проходять перевірки звичайного завантаження (parseRecordStream),
+    // 0 для решти. Будується разом з індексом.
+    const std::vector<unsigned char>& validRecords();
+    bool isValidRecord(std::size_t recordIndex);
+    // Кидає std::invalid_argument, якщо запис не проходить перевірки.
+    WasteRecord record(std::size_t recordIndex);
+
+    // Замінює вміст черги всіма коректними записами файлу, як loadQueueFromFile.
+    void materialize(Queue& queue);
+
+private:
+    std::string path;
+    const char* data = nullptr;
+    std::size_t size = 0;
+    std::string buffer;  // вміст файлу там, де відображення в пам'ять недоступне
+
+    bool indexed = false;
+    std::vector<std::uint64_t> recordOffsets;
+    std::size_t incompleteRecords = 0;
+
+    Column<PhysicalState> stateColumn;
+    Column<std::int32_t> dateKeyColumn;
+    Column<int> quantityColumn;
+    Column<double> costColumn;
+    std::vector<unsigned char> recordValid;
+
+    void ensureIndexed();
+    template <typename T, typename Parse>
+    const Column<T>& decodeColumn(Column<T>& column, RecordField recordField, Parse&& parse);
+};
+
+// Звіти з reports.h над лінивим файлом. Враховуються лише записи з validRecords(), тож
+// результат збігається з результатом для черги, заповненої materialize.
+std::set<std::string> companiesByWasteAndDate(MappedRecordFile& file, const std::string& wasteName,
+                                              const std::string& removalDate);
+CostReport costByCompanyAndWaste(MappedRecordFile& file, const std::string& companyName, const std::string& wasteName);
+std::set<std::string> companiesByPhysicalState(MappedRecordFile& file, PhysicalState state);
+// Кидає std::invalid_argument за тих самих умов, що й версія для черги.
+QuantityReport quantityByCompanyAndDateRange(MappedRecordFile& file, const std::string& companyName,
+                                             const std::string& startDate, const std::string& endDate);
+
+#endif
@@ -0,0 +1,321 @@
+#include "merge_load.h"
+
+#include "metrics.h"
+#include "protocol.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+// Скільки записів упорядковується в пам'яті, перш ніж частина скидається у тимчасовий файл.
+constexpr std::size_t RUN_RECORD_LIMIT = 64 * 1024;
+// Скільки тимчасових файлів зливається за один прохід.
+constexpr std::size_t MAX_MERGE_FAN_IN = 16;
+constexpr std::size_t RUN_IO_CHUNK_SIZE = 64 * 1024;
+
+std::runtime_error tempFileError(const char* action) {
+    return std::runtime_error(std::string(action) + " тимчасового файлу: " + std::strerror(errno));
+}
+
+// Упорядкована за датою частина вхідних записів у тимчасовому файлі. Кожен запис - кадр
+// protocol.h із ключем дати та самим записом, тож при злитті ключ не обчислюється
+// повторно, а проміжне злиття копіює кадри без розбору. std::tmpfile видаляє файл
+// під час закриття, зокрема й при винятку.
+class RunFile {
+public:
+    RunFile() : file(std::tmpfile(), &std::fclose) {
+        if (!file) {
+            throw tempFileError("Помилка створення");
+        }
+    }
+
+    void append(const std::int32_t dateKey, const WasteRecord& record) {
+        const std::size_t frameStart = beginFrame(buffer);
+        ProtocolWriter writer(buffer);
+        writer.putI32(dateKey);
+        writer.putRecord(record);
+        finishFrame(buffer, frameStart);
+        flushIfFull();
+    }
+
+    // Дописує поточний кадр іншої частини без розбору.
+    void appendCurrentOf(const RunFile& source) {
+        const std::size_t frameStart = beginFrame(buffer);
+        buffer.append(source.payload, source.payloadSize);
+        finishFrame(buffer, frameStart);
+        flushIfFull();
+    }
+
+    // Завершує запис і перемотує файл на початок для читання.
+    void finishWriting() {
+        writeBuffer();
+        if (std::fflush(file.get()) != 0) {
+            throw tempFileError("Помилка запису");
+        }
+        std::rewind(file.get());
+        buffer.clear();
+        offset = 0;
+    }
+
+    // Переходить до наступного запису; false - частину вичерпано.
+    bool advance() {
+        while (!nextFrame(buffer, offset, payload, payloadSize)) {
+            buffer.erase(0, offset);
+            offset = 0;
+            const std::size_t oldSize = buffer.size();
+            buffer.resize(oldSize + RUN_IO_CHUNK_SIZE);
+            const std::size_t received = std::fread(&buffer[oldSize], 1, RUN_IO_CHUNK_SIZE, file.get());
+            buffer.resize(oldSize + received);
+            if (received == 0) {
+                if (std::ferror(file.get())) {
+                    throw tempFileError("Помилка читання");
+                }
+                if (!buffer.empty()) {
+                    throw std::runtime_error("Тимчасовий файл обірвано посеред запису");
+                }
+                return false;
+            }
+        }
+        ProtocolReader reader(payload, payloadSize);
+        dateKey = reader.getI32();
+        return true;
+    }
+
+    std::int32_t currentDateKey() const {
+        return dateKey;
+    }
+
+    WasteRecord currentRecord() const {
+        ProtocolReader reader(payload, payloadSize);
+        reader.getI32();
+        return reader.getRecord();
+    }
+
+private:
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file;
+    std::string buffer;
+    std::size_t offset = 0;
+    const char* payload = nullptr;
+    std::size_t payloadSize = 0;
+    std::int32_t dateKey = 0;
+
+    void flushIfFull() {
+        if (buffer.size() >= RUN_IO_CHUNK_SIZE) {
+            writeBuffer();
+        }
+    }
+
+    void writeBuffer() {
+        if (std::fwrite(buffer.data(), 1, buffer.size(), file.get()) != buffer.size()) {
+            throw tempFileError("Помилка запису");
+        }
+        buffer.clear();
+    }
+};
+
+struct RunHead {
+    std::int32_t dateKey;
+    std::size_t run;
+};
+
+// K-шляхове злиття частин [first, last): onRecord отримує частину, чий поточний запис
+// іде наступним. За однакової дати першою йде частина, що стоїть раніше у списку.
+template <typename OnRecord>
+void mergeRuns(std::vector<RunFile>& runs, const std::size_t first, const std::size_t last, OnRecord&& onRecord) {
+    auto later = [](const RunHead& left, const RunHead& right) {
+        return left.dateKey != right.dateKey ? left.dateKey > right.dateKey : left.run > right.run;
+    };
+    std::priority_queue<RunHead, std::vector<RunHead>, decltype(later)> heads(later);
+    for (std::size_t i = first; i < last; ++i) {
+        if (runs[i].advance()) {
+            heads.push(RunHead{ runs[i].currentDateKey(), i });
+        }
+    }
+    while (!heads.empty()) {
+        const std::size_t runIndex = heads.top().run;
+        heads.pop();
+        onRecord(runs[runIndex]);
+        if (runs[runIndex].advance()) {
+            heads.push(RunHead{ runs[runIndex].currentDateKey(), runIndex });
+        }
+    }
+}
+
+// Приймає записи в порядку файлів, упорядковує їх частинами по RUN_RECORD_LIMIT і скидає
+// у тимчасові файли. Щойно в кінці списку набирається MAX_MERGE_FAN_IN частин одного
+// рівня, вони зливаються в одну частину наступного рівня: частини лишаються в порядку
+// надходження записів, а відкритих файлів - не більше MAX_MERGE_FAN_IN на рівень.
+class RunSpiller {
+public:
+    void add(WasteRecord&& record) {
+        chunk.push_back(std::move(record));
+        if (chunk.size() == RUN_RECORD_LIMIT) {
+            spillChunk();
+        }
+    }
+
+    std::vector<RunFile> finish() {
+        spillChunk();
+        return std::move(runs);
+    }
+
+private:
+    std::vector<WasteRecord> chunk;
+    std::vector<std::int32_t> dateKeys;
+    std::vector<std::uint32_t> order;
+    std::vector<RunFile> runs;
+    std::vector<int> levels;
+
+    void spillChunk() {
+        if (chunk.empty()) {
+            return;
+        }
+        dateKeys.resize(chunk.size());
+        order.resize(chunk.size());
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            dateKeys[i] = dateSortKey(chunk[i].removalDate);
+        }
+        std::iota(order.begin(), order.end(), 0u);
+        // Стабільне сортування зберігає порядок файлу для записів з однаковою датою.
+        std::stable_sort(order.begin(), order.end(), [this](const std::uint32_t left, const std::uint32_t right) {
+            return dateKeys[left] < dateKeys[right];
+        });
+
+        RunFile run;
+        for (const std::uint32_t index : order) {
+            run.append(dateKeys[index], chunk[index]);
+        }
+        run.finishWriting();
+        chunk.clear();
+        runs.push_back(std::move(run));
+        levels.push_back(0);
+
+        // Рівні не зростають уздовж списку, тож досить порівняти перший і останній.
+        while (runs.size() >= MAX_MERGE_FAN_IN && levels[runs.size() - MAX_MERGE_FAN_IN] == levels.back()) {
+            const std::size_t first = runs.size() - MAX_MERGE_FAN_IN;
+            RunFile merged;
+            mergeRuns(runs, first, runs.size(), [&merged](const RunFile& source) {
+                merged.appendCurrentOf(source);
+            });
+            merged.finishWriting();
+            const int level = levels.back() + 1;
+            runs.erase(runs.begin() + static_cast<std::ptrdiff_t>(first), runs.end());
+            levels.erase(levels.begin() + static_cast<std::ptrdiff_t>(first), levels.end());
+            runs.push_back(std::move(merged));
+            levels.push_back(level);
+        }
+    }
+};
+
+std::int64_t costInCents(const double cost) {
+    return std::llround(cost * 100.0);
+}
+
+// FNV-1a по полях, що визначають вивезення; нульовий байт після рядка
+// не дає парам на кшталт "AB"+"C" та "A"+"BC" давати однаковий потік байтів.
+std::uint64_t pickupHash(const WasteRecord& record) {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mixByte = [&hash](const unsigned char byte) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    };
+    auto mixString = [&mixByte](const std::string& value) {
+        for (const char c : value) {
+            mixByte(static_cast<unsigned char>(c));
+        }
+        mixByte(0);
+    };
+    auto mixInteger = [&mixByte](std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            mixByte(static_cast<unsigned char>(value & 0xFF));
+            value >>= 8;
+        }
+    };
+    mixString(record.companyCode);
+    mixString(record.wasteCode);
+    mixString(record.removalDate);
+    mixInteger(static_cast<std::uint64_t>(static_cast<std::int64_t>(record.quantity)));
+    mixInteger(static_cast<std::uint64_t>(costInCents(record.cost)));
+    return hash;
+}
+
+// Вартість порівнюється з точністю до копійки - саме так її зберігає текстовий формат.
+bool isSamePickup(const WasteRecord& left, const WasteRecord& right) {
+    return left.companyCode == right.companyCode &&
+        left.wasteCode == right.wasteCode &&
+        left.removalDate == right.removalDate &&
+        left.quantity == right.quantity &&
+        costInCents(left.cost) == costInCents(right.cost);
+}
+
+using PickupRegistry = std::unordered_multimap<std::uint64_t, const WasteRecord*>;
+
+bool isKnownPickup(const PickupRegistry& known, const std::uint64_t hash, const WasteRecord& record) {
+    const auto range = known.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (isSamePickup(*it->second, record)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool mergeQueueFromFiles(Queue& queue, const std::vector<std::string>& filenames, MergeLoadStats& stats) {
+    ILONA_TIME_OPERATION(MetricOperation::MergeLoad);
+    stats = MergeLoadStats{};
+
+    try {
+        std::vector<RunFile> runs;
+        {
+            RunSpiller spiller;
+            for (const std::string& filename : filenames) {
+                const bool readOk = readRecordsFromFile(filename, [&spiller, &stats](WasteRecord&& record) {
+                    spiller.add(std::move(record));
+                    ++stats.recordsRead;
+                });
+                if (!readOk) {
+                    return false;
+                }
+                ++stats.filesRead;
+            }
+            runs = spiller.finish();
+        }
+
+        PickupRegistry known;
+        known.reserve(queue.size + stats.recordsRead);
+        for (const WasteNode* current = queue.head; current != nullptr; current = current->next) {
+            known.emplace(pickupHash(current->data), &current->data);
+        }
+
+        mergeRuns(runs, 0, runs.size(), [&](const RunFile& source) {
+            WasteRecord record = source.currentRecord();
+            const std::uint64_t hash = pickupHash(record);
+            if (isKnownPickup(known, hash, record)) {
+                ++stats.duplicatesSkipped;
+            } else {
+                enqueue(queue, std::move(record));
+                known.emplace(hash, &queue.tail->data);
+                ++stats.recordsAdded;
+            }
+        });
+    } catch (const std::runtime_error& ex) {
+        std::cerr << "Помилка злиття файлів: " << ex.what() << std::endl;
+        return false;
+    }
+
+    ILONA_COUNT(MetricCounter::DuplicatesSkipped, stats.duplicatesSkipped);
+    return true;
+}
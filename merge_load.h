@@ -0,0 +1,31 @@
+#ifndef ILONA_MERGE_LOAD_H
+#define ILONA_MERGE_LOAD_H
+
+#include "waste_queue.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Об'єднання кількох файлів даних (наприклад, щоденних вивантажень різних складів)
+// із чергою, що вже є в пам'яті. Зовнішнє сортування злиттям: файли читаються
+// послідовно, записи впорядковуються за датою вивезення частинами фіксованого розміру
+// і скидаються в тимчасові файли, потім k-шляхове злиття через купу дописує записи в
+// кінець черги у хронологічному порядку. Поза самою чергою в пам'яті тримається лише
+// одна частина та буфери відкритих тимчасових файлів, хоч би якими великими були файли.
+// Дублікати - однакові код підприємства, код відходу, дата, кількість і вартість -
+// пропускаються, зокрема й ті, що вже є в черзі.
+
+struct MergeLoadStats {
+    std::size_t filesRead = 0;
+    std::size_t recordsRead = 0;
+    std::size_t recordsAdded = 0;
+    std::size_t duplicatesSkipped = 0;
+};
+
+// Повертає false, якщо хоча б один файл не вдалося прочитати (тоді черга не змінюється)
+// або якщо тимчасовий файл не вдалося записати чи прочитати; у другому випадку записи,
+// додані до помилки, лишаються в черзі.
+bool mergeQueueFromFiles(Queue& queue, const std::vector<std::string>& filenames, MergeLoadStats& stats);
+
+#endif
@@ -0,0 +1,232 @@
+#include "metrics.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+
+namespace {
+
+// Кошик i містить тривалості з діапазону [2^i, 2^(i+1)) нс, останній - усі довші.
+constexpr std::size_t HISTOGRAM_BUCKETS = 40;
+constexpr std::size_t OPERATION_COUNT = static_cast<std::size_t>(MetricOperation::Count);
+constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(MetricCounter::Count);
+
+struct LatencyHistogram {
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> totalNs{0};
+    std::atomic<std::uint64_t> maxNs{0};
+    std::array<std::atomic<std::uint64_t>, HISTOGRAM_BUCKETS> buckets{};
+};
+
+std::array<LatencyHistogram, OPERATION_COUNT> histograms;
+std::array<std::atomic<std::uint64_t>, COUNTER_COUNT> counters{};
+
+const char* operationName(const MetricOperation operation) {
+    switch (operation) {
+    case MetricOperation::Enqueue: return "enqueue";
+    case MetricOperation::Dequeue: return "dequeue";
+    case MetricOperation::LoadFile: return "load_file";
+    case MetricOperation::SaveFile: return "save_file";
+    case MetricOperation::Sort: return "sort";
+    case MetricOperation::ReportCompaniesByWasteAndDate: return "report_companies_by_waste_and_date";
+    case MetricOperation::ReportServiceCost: return "report_service_cost";
+    case MetricOperation::ReportCompaniesByPhysicalState: return "report_companies_by_physical_state";
+    case MetricOperation::ReportWasteCountByDateRange: return "report_waste_count_by_date_range";
+    case MetricOperation::BulkUpdate: return "bulk_update";
+    case MetricOperation::BulkDelete: return "bulk_delete";
+    case MetricOperation::MergeLoad: return "merge_load";
+    case MetricOperation::ReportTrends: return "report_trends";
+    case MetricOperation::IndexMappedFile: return "index_mapped_file";
+    default: return "unknown";
+    }
+}
+
+const char* counterName(const MetricCounter counter) {
+    switch (counter) {
+    case MetricCounter::BytesRead: return "bytes_read";
+    case MetricCounter::BytesWritten: return "bytes_written";
+    case MetricCounter::RecordsLoaded: return "records_loaded";
+    case MetricCounter::RecordsSaved: return "records_saved";
+    case MetricCounter::ParseErrorsSkipped: return "parse_errors_skipped";
+    case MetricCounter::ReportCacheHits: return "report_cache_hits";
+    case MetricCounter::ReportCacheMisses: return "report_cache_misses";
+    case MetricCounter::ReportCacheInvalidations: return "report_cache_invalidations";
+    case MetricCounter::DuplicatesSkipped: return "duplicates_skipped";
+    default: return "unknown";
+    }
+}
+
+std::size_t bucketFor(std::uint64_t nanoseconds) {
+    std::size_t bucket = 0;
+    while (nanoseconds > 1 && bucket + 1 < HISTOGRAM_BUCKETS) {
+        nanoseconds >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+// Верхня межа кошика; для останнього - максимальне зафіксоване значення.
+std::uint64_t bucketUpperBoundNs(const LatencyHistogram& histogram, const std::size_t bucket) {
+    if (bucket + 1 == HISTOGRAM_BUCKETS) {
+        return histogram.maxNs.load(std::memory_order_relaxed);
+    }
+    return std::uint64_t(1) << (bucket + 1);
+}
+
+std::uint64_t estimatePercentileNs(const LatencyHistogram& histogram, const double fraction) {
+    const std::uint64_t count = histogram.count.load(std::memory_order_relaxed);
+    if (count == 0) {
+        return 0;
+    }
+    const std::uint64_t rank = static_cast<std::uint64_t>(fraction * static_cast<double>(count - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+        seen += histogram.buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucketUpperBoundNs(histogram, bucket), histogram.maxNs.load(std::memory_order_relaxed));
+        }
+    }
+    return histogram.maxNs.load(std::memory_order_relaxed);
+}
+
+MetricOperation operationAt(const std::size_t index) {
+    return static_cast<MetricOperation>(index);
+}
+
+MetricCounter counterAt(const std::size_t index) {
+    return static_cast<MetricCounter>(index);
+}
+
+} // namespace
+
+void recordOperationLatency(const MetricOperation operation, const std::uint64_t nanoseconds) {
+    LatencyHistogram& histogram = histograms[static_cast<std::size_t>(operation)];
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.totalNs.fetch_add(nanoseconds, std::memory_order_relaxed);
+    histogram.buckets[bucketFor(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+
+    std::uint64_t currentMax = histogram.maxNs.load(std::memory_order_relaxed);
+    while (nanoseconds > currentMax &&
+           !histogram.maxNs.compare_exchange_weak(currentMax, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+void addToCounter(const MetricCounter counter, const std::uint64_t value) {
+    counters[static_cast<std::size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+void resetMetrics() {
+    for (LatencyHistogram& histogram : histograms) {
+        histogram.count.store(0, std::memory_order_relaxed);
+        histogram.totalNs.store(0, std::memory_order_relaxed);
+        histogram.maxNs.store(0, std::memory_order_relaxed);
+        for (std::atomic<std::uint64_t>& bucket : histogram.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (std::atomic<std::uint64_t>& counter : counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+void printMetrics(std::ostream& out) {
+    if (!metricsEnabled()) {
+        out << "Метрики вимкнено під час збирання (ILONA_ENABLE_METRICS=OFF).\n";
+        return;
+    }
+
+    out << "\n===== МЕТРИКИ =====\n";
+    for (std::size_t i = 0; i < OPERATION_COUNT; ++i) {
+        const LatencyHistogram& histogram = histograms[i];
+        const std::uint64_t count = histogram.count.load(std::memory_order_relaxed);
+        out << operationName(operationAt(i)) << ": кількість " << count;
+        if (count > 0) {
+            out << ", середнє " << histogram.totalNs.load(std::memory_order_relaxed) / count << " нс"
+                << ", p50 <= " << estimatePercentileNs(histogram, 0.50) << " нс"
+                << ", p99 <= " << estimatePercentileNs(histogram, 0.99) << " нс"
+                << ", макс " << histogram.maxNs.load(std::memory_order_relaxed) << " нс";
+        }
+        out << "\n";
+    }
+    out << "\nЛічильники:\n";
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+        out << "  " << counterName(counterAt(i)) << ": " << counters[i].load(std::memory_order_relaxed) << "\n";
+    }
+
+    const std::uint64_t cacheHits = counters[static_cast<std::size_t>(MetricCounter::ReportCacheHits)].load(std::memory_order_relaxed);
+    const std::uint64_t cacheLookups = cacheHits +
+        counters[static_cast<std::size_t>(MetricCounter::ReportCacheMisses)].load(std::memory_order_relaxed);
+    if (cacheLookups > 0) {
+        out << "Частка влучань кешу звітів: " << 100 * cacheHits / cacheLookups << "%\n";
+    }
+}
+
+bool writeMetricsJson(const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    out << "{\n  \"enabled\": " << (metricsEnabled() ? "true" : "false") << ",\n  \"operations\": {\n";
+    for (std::size_t i = 0; i < OPERATION_COUNT; ++i) {
+        const LatencyHistogram& histogram = histograms[i];
+        out << "    \"" << operationName(operationAt(i)) << "\": {"
+            << "\"count\": " << histogram.count.load(std::memory_order_relaxed)
+            << ", \"total_ns\": " << histogram.totalNs.load(std::memory_order_relaxed)
+            << ", \"max_ns\": " << histogram.maxNs.load(std::memory_order_relaxed)
+            << ", \"p50_ns\": " << estimatePercentileNs(histogram, 0.50)
+            << ", \"p99_ns\": " << estimatePercentileNs(histogram, 0.99)
+            << ", \"buckets\": [";
+        bool first = true;
+        for (std::size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+            const std::uint64_t bucketCount = histogram.buckets[bucket].load(std::memory_order_relaxed);
+            if (bucketCount == 0) {
+                continue;
+            }
+            out << (first ? "" : ", ") << "{\"le_ns\": " << bucketUpperBoundNs(histogram, bucket)
+                << ", \"count\": " << bucketCount << "}";
+            first = false;
+        }
+        out << "]}" << (i + 1 < OPERATION_COUNT ? "," : "") << "\n";
+    }
+    out << "  },\n  \"counters\": {\n";
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+        out << "    \"" << counterName(counterAt(i)) << "\": " << counters[i].load(std::memory_order_relaxed)
+            << (i + 1 < COUNTER_COUNT ? "," : "") << "\n";
+    }
+    out << "  }\n}\n";
+    return static_cast<bool>(out);
+}
+
+bool writeMetricsPrometheus(const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    out << "# HELP ilona_operation_duration_seconds Тривалість операцій.\n"
+        << "# TYPE ilona_operation_duration_seconds histogram\n";
+    for (std::size_t i = 0; i < OPERATION_COUNT; ++i) {
+        const LatencyHistogram& histogram = histograms[i];
+        const char* name = operationName(operationAt(i));
+        std::uint64_t cumulative = 0;
+        for (std::size_t bucket = 0; bucket + 1 < HISTOGRAM_BUCKETS; ++bucket) {
+            cumulative += histogram.buckets[bucket].load(std::memory_order_relaxed);
+            out << "ilona_operation_duration_seconds_bucket{operation=\"" << name << "\",le=\""
+                << static_cast<double>(bucketUpperBoundNs(histogram, bucket)) / 1e9 << "\"} " << cumulative << "\n";
+        }
+        out << "ilona_operation_duration_seconds_bucket{operation=\"" << name << "\",le=\"+Inf\"} "
+            << histogram.count.load(std::memory_order_relaxed) << "\n"
+            << "ilona_operation_duration_seconds_sum{operation=\"" << name << "\"} "
+            << static_cast<double>(histogram.totalNs.load(std::memory_order_relaxed)) / 1e9 << "\n"
+            << "ilona_operation_duration_seconds_count{operation=\"" << name << "\"} "
+            << histogram.count.load(std::memory_order_relaxed) << "\n";
+    }
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+        const char* name = counterName(counterAt(i));
+        out << "# TYPE ilona_" << name << "_total counter\n"
+            << "ilona_" << name << "_total " << counters[i].load(std::memory_order_relaxed) << "\n";
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,87 @@
+#ifndef ILONA_METRICS_H
+#define ILONA_METRICS_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Лічильники та гістограми затримок гарячих операцій.
+// Збираються лише якщо визначено ILONA_ENABLE_METRICS (опція CMake);
+// інакше макроси ILONA_TIME_OPERATION та ILONA_COUNT розгортаються в нічого.
+
+enum class MetricOperation {
+    Enqueue,
+    Dequeue,
+    LoadFile,
+    SaveFile,
+    Sort,
+    ReportCompaniesByWasteAndDate,
+    ReportServiceCost,
+    ReportCompaniesByPhysicalState,
+    ReportWasteCountByDateRange,
+    BulkUpdate,
+    BulkDelete,
+    MergeLoad,
+    ReportTrends,
+    IndexMappedFile,
+    Count
+};
+
+enum class MetricCounter {
+    BytesRead,
+    BytesWritten,
+    RecordsLoaded,
+    RecordsSaved,
+    ParseErrorsSkipped,
+    ReportCacheHits,
+    ReportCacheMisses,
+    ReportCacheInvalidations,
+    DuplicatesSkipped,
+    Count
+};
+
+constexpr bool metricsEnabled() {
+#ifdef ILONA_ENABLE_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void recordOperationLatency(MetricOperation operation, std::uint64_t nanoseconds);
+void addToCounter(MetricCounter counter, std::uint64_t value);
+void resetMetrics();
+
+void printMetrics(std::ostream& out);
+bool writeMetricsJson(const std::string& filename);
+bool writeMetricsPrometheus(const std::string& filename);
+
+class ScopedOperationTimer {
+public:
+    explicit ScopedOperationTimer(const MetricOperation operation)
+        : operation(operation), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedOperationTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        recordOperationLatency(operation, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    ScopedOperationTimer(const ScopedOperationTimer&) = delete;
+    ScopedOperationTimer& operator=(const ScopedOperationTimer&) = delete;
+
+private:
+    MetricOperation operation;
+    std::chrono::steady_clock::time_point start;
+};
+
+#ifdef ILONA_ENABLE_METRICS
+#define ILONA_TIME_OPERATION(operation) const ScopedOperationTimer ilonaOperationTimer(operation)
+#define ILONA_COUNT(counter, value) addToCounter(counter, static_cast<std::uint64_t>(value))
+#else
+#define ILONA_TIME_OPERATION(operation) static_cast<void>(0)
+#define ILONA_COUNT(counter, value) static_cast<void>(0)
+#endif
+
+#endif
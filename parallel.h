@@ -0,0 +1,86 @@
+#ifndef ILONA_PARALLEL_H
+#define ILONA_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+inline std::size_t workerThreadCount() {
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads == 0 ? 1 : hardwareThreads;
+}
+
+// Обробляє діапазон [0, count) шматками по chunkSize елементів у кількох потоках.
+// fn(begin, end) викликається з робочих потоків, тому має бути потокобезпечною.
+// Перший виняток, кинутий у будь-якому потоці, повторно кидається у викликаючому потоці.
+// Якщо не вдалося створити потік, кидається std::system_error; частина шматків тоді не оброблена.
+template <typename Fn>
+void parallelFor(const std::size_t count, std::size_t chunkSize, Fn&& fn) {
+    if (count == 0) {
+        return;
+    }
+    chunkSize = std::max<std::size_t>(chunkSize, 1);
+    const std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    const std::size_t threadCount = std::min(workerThreadCount(), chunkCount);
+
+    if (threadCount <= 1) {
+        for (std::size_t begin = 0; begin < count; begin += chunkSize) {
+            fn(begin, std::min(begin + chunkSize, count));
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> nextChunk{0};
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        while (true) {
+            const std::size_t chunk = nextChunk.fetch_add(1);
+            if (chunk >= chunkCount) {
+                return;
+            }
+            const std::size_t begin = chunk * chunkSize;
+            try {
+                fn(begin, std::min(begin + chunkSize, count));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+                nextChunk.store(chunkCount);
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    try {
+        for (std::size_t i = 1; i < threadCount; ++i) {
+            threads.emplace_back(worker);
+        }
+    } catch (...) {
+        // Потік не створився (std::system_error): запущені потоки мають завершитися до
+        // виходу, інакше деструктор std::thread викличе std::terminate.
+        nextChunk.store(chunkCount);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        throw;
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+#endif
@@ -0,0 +1,171 @@
+#include "pickup_priority.h"
+
+#include <queue>
+#include <stdexcept>
+
+PickupPriorityView::PickupPriorityView(Queue& queue) : queue(queue) {
+    heap.reserve(queue.size);
+    positions.reserve(queue.size);
+    for (const WasteNode* current = queue.head; current != nullptr; current = current->next) {
+        place(heap.size(), makeEntry(*current));
+    }
+    // Побудова купи знизу вгору - O(n) замість n вставок.
+    if (heap.size() > 1) {
+        for (std::size_t index = (heap.size() - 2) / ARITY + 1; index-- > 0;) {
+            siftDown(index);
+        }
+    }
+    addQueueListener(queue, this);
+}
+
+PickupPriorityView::~PickupPriorityView() {
+    removeQueueListener(queue, this);
+}
+
+const WasteNode& PickupPriorityView::top() const {
+    if (heap.empty()) {
+        throw std::out_of_range("Черга порожня");
+    }
+    return *heap.front().node;
+}
+
+WasteRecord PickupPriorityView::popNext() {
+    if (heap.empty()) {
+        throw std::out_of_range("Черга порожня");
+    }
+    // Вузол належить queue, яку подання тримає за неконстантним посиланням;
+    // removeNode сповістить спостерігачів, зокрема і це подання.
+    return removeNode(queue, const_cast<WasteNode*>(heap.front().node));
+}
+
+std::vector<const WasteNode*> PickupPriorityView::upcoming(const std::size_t count) const {
+    std::vector<const WasteNode*> result;
+    if (heap.empty() || count == 0) {
+        return result;
+    }
+    result.reserve(count);
+
+    // Обхід купи "найкращий спершу": кандидатами стають лише діти вже виданих вузлів.
+    auto lowerPriority = [this](const std::size_t left, const std::size_t right) {
+        return higherPriority(heap[right], heap[left]);
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(lowerPriority)> frontier(lowerPriority);
+    frontier.push(0);
+    while (!frontier.empty() && result.size() < count) {
+        const std::size_t index = frontier.top();
+        frontier.pop();
+        result.push_back(heap[index].node);
+        const std::size_t firstChild = index * ARITY + 1;
+        for (std::size_t child = firstChild; child < firstChild + ARITY && child < heap.size(); ++child) {
+            frontier.push(child);
+        }
+    }
+    return result;
+}
+
+void PickupPriorityView::onRecordAdded(const WasteNode& node) {
+    place(heap.size(), makeEntry(node));
+    siftUp(heap.size() - 1);
+}
+
+void PickupPriorityView::onRecordRemoved(const WasteNode& node) {
+    const auto found = positions.find(&node);
+    if (found == positions.end()) {
+        return;
+    }
+    const std::size_t index = found->second;
+    positions.erase(found);
+
+    const HeapEntry last = heap.back();
+    heap.pop_back();
+    if (index < heap.size()) {
+        place(index, last);
+        restore(index);
+    }
+}
+
+void PickupPriorityView::onRecordUpdated(const WasteNode& node, const WasteRecord& previous) {
+    if (node.data.removalDate == previous.removalDate && node.data.quantity == previous.quantity) {
+        return;
+    }
+    const auto found = positions.find(&node);
+    if (found == positions.end()) {
+        return;
+    }
+    // Порядок додавання зберігається, змінюється лише ключ.
+    HeapEntry& entry = heap[found->second];
+    entry.dateKey = dateSortKey(node.data.removalDate);
+    entry.quantity = node.data.quantity;
+    restore(found->second);
+}
+
+void PickupPriorityView::onQueueCleared() {
+    heap.clear();
+    positions.clear();
+}
+
+PickupPriorityView::HeapEntry PickupPriorityView::makeEntry(const WasteNode& node) {
+    return HeapEntry{ &node, dateSortKey(node.data.removalDate), node.data.quantity, nextSequence++ };
+}
+
+bool PickupPriorityView::higherPriority(const HeapEntry& left, const HeapEntry& right) {
+    if (left.dateKey != right.dateKey) {
+        return left.dateKey < right.dateKey;
+    }
+    if (left.quantity != right.quantity) {
+        return left.quantity > right.quantity;
+    }
+    return left.sequence < right.sequence;
+}
+
+void PickupPriorityView::place(const std::size_t index, const HeapEntry& entry) {
+    if (index == heap.size()) {
+        heap.push_back(entry);
+    } else {
+        heap[index] = entry;
+    }
+    positions[entry.node] = index;
+}
+
+void PickupPriorityView::siftUp(std::size_t index) {
+    const HeapEntry entry = heap[index];
+    while (index > 0) {
+        const std::size_t parent = (index - 1) / ARITY;
+        if (!higherPriority(entry, heap[parent])) {
+            break;
+        }
+        place(index, heap[parent]);
+        index = parent;
+    }
+    place(index, entry);
+}
+
+void PickupPriorityView::siftDown(std::size_t index) {
+    const HeapEntry entry = heap[index];
+    while (true) {
+        const std::size_t firstChild = index * ARITY + 1;
+        if (firstChild >= heap.size()) {
+            break;
+        }
+        std::size_t best = firstChild;
+        for (std::size_t child = firstChild + 1; child < firstChild + ARITY && child < heap.size(); ++child) {
+            if (higherPriority(heap[child], heap[best])) {
+                best = child;
+            }
+        }
+        if (!higherPriority(heap[best], entry)) {
+            break;
+        }
+        place(index, heap[best]);
+        index = best;
+    }
+    place(index, entry);
+}
+
+void PickupPriorityView::restore(const std::size_t index) {
+    if (index > 0 && higherPriority(heap[index], heap[(index - 1) / ARITY])) {
+        siftUp(index);
+    } else {
+        siftDown(index);
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef ILONA_PICKUP_PRIORITY_H
+#define ILONA_PICKUP_PRIORITY_H
+
+#include "waste_queue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Пріоритетне подання черги для диспетчеризації вивезень: найраніша дата
+// вивезення, за однакової дати - більша кількість, далі - порядок додавання.
+// Індексована 4-арна купа над вузлами тієї ж черги: додавання, вилучення
+// та зміна ключа за O(log n); черга лишається доступною і як FIFO.
+// Черга має жити довше за подання.
+class PickupPriorityView : public QueueListener {
+public:
+    explicit PickupPriorityView(Queue& queue);
+    ~PickupPriorityView() override;
+
+    PickupPriorityView(const PickupPriorityView&) = delete;
+    PickupPriorityView& operator=(const PickupPriorityView&) = delete;
+
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+
+    // Кидає std::out_of_range, якщо черга порожня.
+    const WasteNode& top() const;
+    // Вилучає найпріоритетніший запис із черги (не лише з подання) і повертає його.
+    WasteRecord popNext();
+    // До count найпріоритетніших вузлів по порядку, без зміни черги; O(count log count).
+    std::vector<const WasteNode*> upcoming(std::size_t count) const;
+
+    void onRecordAdded(const WasteNode& node) override;
+    void onRecordRemoved(const WasteNode& node) override;
+    void onRecordUpdated(const WasteNode& node, const WasteRecord& previous) override;
+    void onQueueCleared() override;
+
+private:
+    struct HeapEntry {
+        const WasteNode* node;
+        std::int32_t dateKey;  // РРРРММДД; некоректні дати - у кінці
+        std::int32_t quantity;
+        std::uint64_t sequence;
+    };
+
+    static constexpr std::size_t ARITY = 4;
+
+    Queue& queue;
+    std::vector<HeapEntry> heap;
+    std::unordered_map<const WasteNode*, std::size_t> positions;
+    std::uint64_t nextSequence = 0;
+
+    HeapEntry makeEntry(const WasteNode& node);
+    static bool higherPriority(const HeapEntry& left, const HeapEntry& right);
+    void place(std::size_t index, const HeapEntry& entry);
+    void siftUp(std::size_t index);
+    void siftDown(std::size_t index);
+    void restore(std::size_t index);
+};
+
+#endif
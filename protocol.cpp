@@ -0,0 +1,307 @@
+#include "protocol.h"
+
+#include "reports.h"
+
+#include <cstring>
+#include <set>
+
+namespace {
+
+void putLittleEndian(std::string& out, const std::uint64_t value, const int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+std::uint64_t getLittleEndian(const char* p, const int bytes) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return value;
+}
+
+void putCompanyList(ProtocolWriter& writer, const std::set<std::string>& companies) {
+    writer.putU32(static_cast<std::uint32_t>(companies.size()));
+    for (const std::string& company : companies) {
+        writer.putString(company);
+    }
+}
+
+void requireEnd(const ProtocolReader& reader) {
+    if (!reader.atEnd()) {
+        throw ProtocolError("Зайві байти в запиті");
+    }
+}
+
+} // namespace
+
+void ProtocolWriter::putU8(const std::uint8_t value) {
+    out.push_back(static_cast<char>(value));
+}
+
+void ProtocolWriter::putU32(const std::uint32_t value) {
+    putLittleEndian(out, value, 4);
+}
+
+void ProtocolWriter::putU64(const std::uint64_t value) {
+    putLittleEndian(out, value, 8);
+}
+
+void ProtocolWriter::putI32(const std::int32_t value) {
+    putLittleEndian(out, static_cast<std::uint32_t>(value), 4);
+}
+
+void ProtocolWriter::putI64(const std::int64_t value) {
+    putLittleEndian(out, static_cast<std::uint64_t>(value), 8);
+}
+
+void ProtocolWriter::putF64(const double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU64(bits);
+}
+
+void ProtocolWriter::putString(const std::string& value) {
+    putU32(static_cast<std::uint32_t>(value.size()));
+    out.append(value);
+}
+
+void ProtocolWriter::putRecord(const WasteRecord& record) {
+    putString(record.companyCode);
+    putString(record.companyName);
+    putString(record.address);
+    putString(record.phone);
+    putString(record.wasteCode);
+    putString(record.wasteName);
+    putU8(static_cast<std::uint8_t>(record.state));
+    putString(record.removalDate);
+    putI32(record.quantity);
+    putF64(record.cost);
+}
+
+const char* ProtocolReader::take(const std::size_t count) {
+    if (static_cast<std::size_t>(end - current) < count) {
+        throw ProtocolError("Обрізаний запит");
+    }
+    const char* start = current;
+    current += count;
+    return start;
+}
+
+std::uint8_t ProtocolReader::getU8() {
+    return static_cast<std::uint8_t>(*take(1));
+}
+
+std::uint32_t ProtocolReader::getU32() {
+    return static_cast<std::uint32_t>(getLittleEndian(take(4), 4));
+}
+
+std::uint64_t ProtocolReader::getU64() {
+    return getLittleEndian(take(8), 8);
+}
+
+std::int32_t ProtocolReader::getI32() {
+    return static_cast<std::int32_t>(getU32());
+}
+
+std::int64_t ProtocolReader::getI64() {
+    return static_cast<std::int64_t>(getU64());
+}
+
+double ProtocolReader::getF64() {
+    const std::uint64_t bits = getU64();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string ProtocolReader::getString() {
+    const std::uint32_t length = getU32();
+    const char* data = take(length);
+    return std::string(data, length);
+}
+
+WasteRecord ProtocolReader::getRecord() {
+    std::string companyCode = getString();
+    std::string companyName = getString();
+    std::string address = getString();
+    std::string phone = getString();
+    std::string wasteCode = getString();
+    std::string wasteName = getString();
+    const int stateInt = getU8();
+    if (!isValidPhysicalState(stateInt)) {
+        throw ProtocolError("Некоректний агрегатний стан");
+    }
+    std::string removalDate = getString();
+    const int quantity = getI32();
+    const double cost = getF64();
+    return WasteRecord(std::move(companyCode), std::move(companyName), std::move(address), std::move(phone),
+                       std::move(wasteCode), std::move(wasteName), static_cast<PhysicalState>(stateInt),
+                       std::move(removalDate), quantity, cost);
+}
+
+std::size_t beginFrame(std::string& out) {
+    const std::size_t frameStart = out.size();
+    out.append(FRAME_HEADER_SIZE, '\0');
+    return frameStart;
+}
+
+void finishFrame(std::string& out, const std::size_t frameStart) {
+    const std::uint64_t payloadSize = out.size() - frameStart - FRAME_HEADER_SIZE;
+    for (std::size_t i = 0; i < FRAME_HEADER_SIZE; ++i) {
+        out[frameStart + i] = static_cast<char>((payloadSize >> (8 * i)) & 0xFF);
+    }
+}
+
+bool nextFrame(const std::string& buffer, std::size_t& offset, const char*& payload, std::size_t& payloadSize) {
+    if (buffer.size() - offset < FRAME_HEADER_SIZE) {
+        return false;
+    }
+    const std::uint64_t length = getLittleEndian(buffer.data() + offset, FRAME_HEADER_SIZE);
+    if (length > MAX_FRAME_SIZE) {
+        throw ProtocolError("Кадр перевищує максимальний розмір");
+    }
+    if (buffer.size() - offset - FRAME_HEADER_SIZE < length) {
+        return false;
+    }
+    payload = buffer.data() + offset + FRAME_HEADER_SIZE;
+    payloadSize = static_cast<std::size_t>(length);
+    offset += FRAME_HEADER_SIZE + payloadSize;
+    return true;
+}
+
+void handleProtocolRequest(ProtocolContext& context, const char* payload, const std::size_t payloadSize,
+                           std::string& out) {
+    Queue& queue = context.queue;
+    ReportCache& reportCache = context.reportCache;
+    const std::size_t frameStart = beginFrame(out);
+    ProtocolWriter writer(out);
+
+    auto fail = [&](const ResponseStatus status, const std::string& message) {
+        out.resize(frameStart + FRAME_HEADER_SIZE);
+        writer.putU8(static_cast<std::uint8_t>(status));
+        writer.putString(message);
+    };
+
+    try {
+        ProtocolReader reader(payload, payloadSize);
+        switch (static_cast<RequestType>(reader.getU8())) {
+        case RequestType::Ping: {
+            requireEnd(reader);
+            writer.putU8(static_cast<std::uint8_t>(ResponseStatus::Ok));
+            break;
+        }
+        case RequestType::Enqueue: {
+            WasteRecord record = reader.getRecord();
+            requireEnd(reader);
+            if (const char* error = recordValidationError(record)) {
+                fail(ResponseStatus::BadRequest, error);
+                break;
+            }
+            enqueue(queue, std::move(record));
+            writer.putU8(static_cast<std::uint8_t>(ResponseStatus::Ok));
+            break;
+        }
+        case RequestType::Dequeue:
+        case RequestType::Peek: {
+            const bool remove = static_cast<RequestType>(payload[0]) == RequestType::Dequeue;
+            requireEnd(reader);
+            if (isEmpty(queue)) {
+                fail(ResponseStatus::NotFound, "Черга порожня");
+                break;
+            }
+            writer.putU8(static_cast<std::uint8_t>(ResponseStatus::Ok));
+            writer.putRecord(remove ? dequeue(queue) : queue.head->data);
+            break;
+        }
+        case RequestType::Size: {
+            requireEnd(reader);
+            writer.putU8(static_cast<std::uint8_t>(ResponseStatus::Ok));
+            writer.putU64(queue.size);
+            break;
+        }
+        case RequestType::Update: {
+            const std::string companyName = reader.getString();
+            const std::uint32_t matchIndex = reader.getU32();
+            WasteRecord record = reader.getRecord();
+            requireEnd(reader);
+            if (const char* error = recordValidationError(record)) {
+                fail(ResponseStatus::BadRequest, error);
+                break;
+            }
+            const std::vector<WasteNode*> matchingNodes = findRecordsByCompany(queue, companyName);
+            if (matchIndex >= matchingNodes.size()) {
+                fail(ResponseStatus::NotFound, "Не знайдено запису для підприємства '" + companyName + "'");
+                break;
+            }
+            replaceRecord(queue, *matchingNodes[matchIndex], std::move(record));
+            writer.putU8(static_cast<std::uint8_t>(ResponseStatus::Ok));
+            break;
+        }
+        case RequestType::CompaniesByWasteAndDate: {
+            const std::string wasteName = reader.getString();
+            const std::string removalDate = reader.getString();
+            requireEnd(reader);
+            writer.putU8(static_cast<std::uint8_t>(ResponseStatus::Ok));
+            putCompanyList(writer, reportCache.companiesByWasteAndDate(wasteName, removalDate));
+            break;
+        }
+        case RequestType::CostByCompanyAndWaste: {
+            const std::string companyName = reader.getString();
+            const std::string wasteName = reader.getString();
+            requireEnd(reader);
+            const CostReport report = reportCache.costByCompanyAndWaste(companyName, wasteName);
+            writer.putU8(static_cast<std::uint8_t>(ResponseStatus::Ok));
+            writer.putF64(report.totalCost);
+            writer.putU64(report.matchedRecords);
+            break;
+        }
+        case RequestType::CompaniesByPhysicalState: {
+            const int stateInt = reader.getU8();
+            requireEnd(reader);
+            if (!isValidPhysicalState(stateInt)) {
+                fail(ResponseStatus::BadRequest, "Некоректний агрегатний стан");
+                break;
+            }
+            writer.putU8(static_cast<std::uint8_t>(ResponseStatus::Ok));
+            putCompanyList(writer, reportCache.companiesByPhysicalState(static_cast<PhysicalState>(stateInt)));
+            break;
+        }
+        case RequestType::QuantityByCompanyAndDateRange: {
+            const std::string companyName = reader.getString();
+            const std::string startDate = reader.getString();
+            const std::string endDate = reader.getString();
+            requireEnd(reader);
+            const QuantityReport report = reportCache.quantityByCompanyAndDateRange(companyName, startDate, endDate);
+            writer.putU8(static_cast<std::uint8_t>(ResponseStatus::Ok));
+            writer.putI64(report.totalQuantity);
+            writer.putU64(report.matchedRecords);
+            break;
+        }
+        case RequestType::PeekNextPickup:
+        case RequestType::DispatchNextPickup: {
+            const bool remove = static_cast<RequestType>(payload[0]) == RequestType::DispatchNextPickup;
+            requireEnd(reader);
+            if (context.pickupView.empty()) {
+                fail(ResponseStatus::NotFound, "Черга порожня");
+                break;
+            }
+            writer.putU8(static_cast<std::uint8_t>(ResponseStatus::Ok));
+            writer.putRecord(remove ? context.pickupView.popNext() : context.pickupView.top().data);
+            break;
+        }
+        default:
+            fail(ResponseStatus::BadRequest, "Невідомий код операції");
+            break;
+        }
+    } catch (const ProtocolError& ex) {
+        fail(ResponseStatus::BadRequest, ex.what());
+    } catch (const std::invalid_argument& ex) {
+        fail(ResponseStatus::BadRequest, ex.what());
+    } catch (const std::exception& ex) {
+        fail(ResponseStatus::Error, ex.what());
+    }
+
+    finishFrame(out, frameStart);
+}
@@ -0,0 +1,113 @@
+#ifndef ILONA_PROTOCOL_H
+#define ILONA_PROTOCOL_H
+
+#include "pickup_priority.h"
+#include "report_cache.h"
+#include "waste_queue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Компактний двійковий протокол сервера ilona_server.
+//
+// Кадр: u32 довжина корисного навантаження + навантаження (усі числа little-endian).
+// Запит: u8 код операції + аргументи. Відповідь: u8 статус + результат,
+// для статусів помилок - рядок з описом. Відповіді надходять у порядку запитів,
+// тому клієнт може надсилати наступні запити, не чекаючи відповідей.
+//
+// Рядок: u32 довжина + байти UTF-8. Запис: шість рядків (код і назва підприємства,
+// адреса, телефон, код і назва відходу), u8 агрегатний стан, рядок дати ДД:ММ:РРРР,
+// i32 кількість, f64 вартість.
+
+enum class RequestType : std::uint8_t {
+    Ping = 0,
+    Enqueue = 1,                       // запис -> -
+    Dequeue = 2,                       // - -> запис
+    Peek = 3,                          // - -> запис
+    Size = 4,                          // - -> u64
+    Update = 5,                        // назва підприємства, u32 номер збігу (з 0), запис -> -
+    CompaniesByWasteAndDate = 6,       // назва відходу, дата -> u32 N, N рядків
+    CostByCompanyAndWaste = 7,         // назва підприємства, назва відходу -> f64 сума, u64 записів
+    CompaniesByPhysicalState = 8,      // u8 стан -> u32 N, N рядків
+    QuantityByCompanyAndDateRange = 9, // назва підприємства, дата, дата -> i64 сума, u64 записів
+    PeekNextPickup = 10,               // - -> запис з найвищим пріоритетом вивезення
+    DispatchNextPickup = 11            // - -> запис (вилучається з черги)
+};
+
+enum class ResponseStatus : std::uint8_t {
+    Ok = 0,
+    NotFound = 1,
+    BadRequest = 2,
+    Error = 3
+};
+
+constexpr std::uint32_t MAX_FRAME_SIZE = 16 * 1024 * 1024;
+constexpr std::size_t FRAME_HEADER_SIZE = 4;
+
+class ProtocolError : public std::runtime_error {
+public:
+    explicit ProtocolError(const std::string& message) : std::runtime_error(message) {}
+};
+
+class ProtocolWriter {
+public:
+    explicit ProtocolWriter(std::string& out) : out(out) {}
+
+    void putU8(std::uint8_t value);
+    void putU32(std::uint32_t value);
+    void putU64(std::uint64_t value);
+    void putI32(std::int32_t value);
+    void putI64(std::int64_t value);
+    void putF64(double value);
+    void putString(const std::string& value);
+    void putRecord(const WasteRecord& record);
+
+private:
+    std::string& out;
+};
+
+// Читає поля з навантаження кадру; кидає ProtocolError, якщо даних не вистачає.
+class ProtocolReader {
+public:
+    ProtocolReader(const char* data, std::size_t size) : current(data), end(data + size) {}
+
+    std::uint8_t getU8();
+    std::uint32_t getU32();
+    std::uint64_t getU64();
+    std::int32_t getI32();
+    std::int64_t getI64();
+    double getF64();
+    std::string getString();
+    WasteRecord getRecord();
+    bool atEnd() const { return current == end; }
+
+private:
+    const char* current;
+    const char* end;
+
+    const char* take(std::size_t count);
+};
+
+// Резервує місце під довжину кадру; повертає зміщення для finishFrame.
+std::size_t beginFrame(std::string& out);
+void finishFrame(std::string& out, std::size_t frameStart);
+
+// Шукає повний кадр у buffer починаючи з offset. Якщо кадр є, повертає true,
+// записує межі навантаження і зсуває offset за кадр.
+// Кидає ProtocolError, якщо заявлена довжина більша за MAX_FRAME_SIZE.
+bool nextFrame(const std::string& buffer, std::size_t& offset, const char*& payload, std::size_t& payloadSize);
+
+// Черга і прив'язані до неї похідні структури, над якими виконуються запити.
+struct ProtocolContext {
+    Queue& queue;
+    ReportCache& reportCache;
+    PickupPriorityView& pickupView;
+};
+
+// Виконує один запит і дописує кадр відповіді в out.
+void handleProtocolRequest(ProtocolContext& context, const char* payload, std::size_t payloadSize, std::string& out);
+
+#endif
@@ -0,0 +1,175 @@
+#include "report_cache.h"
+
+#include "metrics.h"
+
+#include <stdexcept>
+
+namespace {
+
+// Верхня межа кількості збережених результатів; при переповненні кеш очищується повністю.
+constexpr std::size_t MAX_CACHED_ENTRIES = 4096;
+
+bool affectsReports(const WasteRecord& left, const WasteRecord& right) {
+    return left.companyName != right.companyName || left.wasteName != right.wasteName ||
+        left.state != right.state || left.removalDate != right.removalDate ||
+        left.quantity != right.quantity || left.cost != right.cost;
+}
+
+} // namespace
+
+ReportCache::ReportCache(Queue& queue) : queue(queue) {
+    addQueueListener(queue, this);
+}
+
+ReportCache::~ReportCache() {
+    removeQueueListener(queue, this);
+}
+
+const std::set<std::string>& ReportCache::companiesByWasteAndDate(const std::string& wasteName,
+                                                                  const std::string& removalDate) {
+    const NamePair key(wasteName, removalDate);
+    const auto cached = companiesByWasteDate.find(key);
+    if (cached != companiesByWasteDate.end()) {
+        ILONA_COUNT(MetricCounter::ReportCacheHits, 1);
+        return cached->second;
+    }
+    ILONA_COUNT(MetricCounter::ReportCacheMisses, 1);
+    reserveEntry();
+    return companiesByWasteDate.emplace(key, ::companiesByWasteAndDate(queue, wasteName, removalDate)).first->second;
+}
+
+CostReport ReportCache::costByCompanyAndWaste(const std::string& companyName, const std::string& wasteName) {
+    const NamePair key(companyName, wasteName);
+    const auto cached = costByCompanyWaste.find(key);
+    if (cached != costByCompanyWaste.end()) {
+        ILONA_COUNT(MetricCounter::ReportCacheHits, 1);
+        return cached->second;
+    }
+    ILONA_COUNT(MetricCounter::ReportCacheMisses, 1);
+    reserveEntry();
+    return costByCompanyWaste.emplace(key, ::costByCompanyAndWaste(queue, companyName, wasteName)).first->second;
+}
+
+const std::set<std::string>& ReportCache::companiesByPhysicalState(const PhysicalState state) {
+    const auto cached = companiesByState.find(state);
+    if (cached != companiesByState.end()) {
+        ILONA_COUNT(MetricCounter::ReportCacheHits, 1);
+        return cached->second;
+    }
+    ILONA_COUNT(MetricCounter::ReportCacheMisses, 1);
+    reserveEntry();
+    return companiesByState.emplace(state, ::companiesByPhysicalState(queue, state)).first->second;
+}
+
+QuantityReport ReportCache::quantityByCompanyAndDateRange(const std::string& companyName, const std::string& startDate,
+                                                          const std::string& endDate) {
+    const DateRange range(convertDateToComparableFormat(startDate), convertDateToComparableFormat(endDate));
+    const auto company = quantityByCompany.find(companyName);
+    if (company != quantityByCompany.end()) {
+        const auto cached = company->second.find(range);
+        if (cached != company->second.end()) {
+            ILONA_COUNT(MetricCounter::ReportCacheHits, 1);
+            return cached->second;
+        }
+    }
+    ILONA_COUNT(MetricCounter::ReportCacheMisses, 1);
+    const QuantityReport report = ::quantityByCompanyAndDateRange(queue, companyName, startDate, endDate);
+    reserveEntry();
+    quantityByCompany[companyName].emplace(range, report);
+    return report;
+}
+
+void ReportCache::invalidateAll() {
+    ILONA_COUNT(MetricCounter::ReportCacheInvalidations, entryCount);
+    companiesByWasteDate.clear();
+    costByCompanyWaste.clear();
+    companiesByState.clear();
+    quantityByCompany.clear();
+    entryCount = 0;
+}
+
+void ReportCache::reserveEntry() {
+    if (entryCount >= MAX_CACHED_ENTRIES) {
+        invalidateAll();
+    }
+    ++entryCount;
+}
+
+template<typename Map, typename Key>
+void ReportCache::eraseEntry(Map& map, const Key& key) {
+    if (map.erase(key) > 0) {
+        --entryCount;
+        ILONA_COUNT(MetricCounter::ReportCacheInvalidations, 1);
+    }
+}
+
+// Сума кількостей ціла, тож результати за діапазонами дат оновлюються на місці
+// (direction = +1 для доданого запису, -1 для видаленого), а не скидаються.
+// Записи з некоректною датою звіт пропускає - як і тут.
+void ReportCache::adjustQuantityEntries(const WasteRecord& record, const int direction) {
+    const auto company = quantityByCompany.find(record.companyName);
+    if (company == quantityByCompany.end()) {
+        return;
+    }
+    std::string date;
+    try {
+        date = convertDateToComparableFormat(record.removalDate);
+    } catch (const std::invalid_argument&) {
+        return;
+    }
+    for (auto& [range, report] : company->second) {
+        if (date >= range.first && date <= range.second) {
+            report.totalQuantity += static_cast<long long>(direction) * record.quantity;
+            report.matchedRecords = direction > 0 ? report.matchedRecords + 1 : report.matchedRecords - 1;
+        }
+    }
+}
+
+void ReportCache::invalidateRecord(const WasteRecord& record) {
+    eraseEntry(companiesByWasteDate, NamePair(record.wasteName, record.removalDate));
+    eraseEntry(costByCompanyWaste, NamePair(record.companyName, record.wasteName));
+    eraseEntry(companiesByState, record.state);
+    adjustQuantityEntries(record, -1);
+}
+
+void ReportCache::onRecordAdded(const WasteNode& node) {
+    const WasteRecord& record = node.data;
+
+    // Множини підприємств лише поповнюються новим записом.
+    const auto byWasteDate = companiesByWasteDate.find(NamePair(record.wasteName, record.removalDate));
+    if (byWasteDate != companiesByWasteDate.end()) {
+        byWasteDate->second.insert(record.companyName);
+    }
+    const auto byState = companiesByState.find(record.state);
+    if (byState != companiesByState.end()) {
+        byState->second.insert(record.companyName);
+    }
+
+    // Суму вартостей перераховуємо, щоб результат збігався з послідовним підсумовуванням звіту.
+    eraseEntry(costByCompanyWaste, NamePair(record.companyName, record.wasteName));
+
+    adjustQuantityEntries(record, +1);
+}
+
+void ReportCache::onRecordRemoved(const WasteNode& node) {
+    invalidateRecord(node.data);
+}
+
+void ReportCache::onRecordUpdated(const WasteNode& node, const WasteRecord& previous) {
+    if (!affectsReports(node.data, previous)) {
+        return;
+    }
+    invalidateRecord(previous);
+    onRecordAdded(node);
+}
+
+void ReportCache::onQueueCleared() {
+    invalidateAll();
+}
+
+void ReportCache::onQueueReordered() {
+    // Суми вартостей залежать від порядку додавання доданків; решта звітів - ні.
+    ILONA_COUNT(MetricCounter::ReportCacheInvalidations, costByCompanyWaste.size());
+    entryCount -= costByCompanyWaste.size();
+    costByCompanyWaste.clear();
+}
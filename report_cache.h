@@ -0,0 +1,61 @@
+#ifndef ILONA_REPORT_CACHE_H
+#define ILONA_REPORT_CACHE_H
+
+#include "reports.h"
+#include "waste_queue.h"
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+// Кеш результатів звітів із reports.h, прив'язаний до черги.
+// Зміна запису скидає лише ті результати, на які впливають змінені поля:
+// наприклад, новий телефон чи адреса не скидають нічого, а новий запис
+// скидає вартість лише для своєї пари (підприємство, відхід).
+// Черга має жити довше за кеш.
+class ReportCache : public QueueListener {
+public:
+    explicit ReportCache(Queue& queue);
+    ~ReportCache() override;
+
+    ReportCache(const ReportCache&) = delete;
+    ReportCache& operator=(const ReportCache&) = delete;
+
+    // Посилання дійсні до наступної зміни черги або наступного запиту до кешу.
+    const std::set<std::string>& companiesByWasteAndDate(const std::string& wasteName, const std::string& removalDate);
+    CostReport costByCompanyAndWaste(const std::string& companyName, const std::string& wasteName);
+    const std::set<std::string>& companiesByPhysicalState(PhysicalState state);
+    // Кидає std::invalid_argument так само, як quantityByCompanyAndDateRange.
+    QuantityReport quantityByCompanyAndDateRange(const std::string& companyName, const std::string& startDate,
+                                                 const std::string& endDate);
+
+    void invalidateAll();
+    std::size_t cachedEntries() const { return entryCount; }
+
+    void onRecordAdded(const WasteNode& node) override;
+    void onRecordRemoved(const WasteNode& node) override;
+    void onRecordUpdated(const WasteNode& node, const WasteRecord& previous) override;
+    void onQueueCleared() override;
+    void onQueueReordered() override;
+
+private:
+    using NamePair = std::pair<std::string, std::string>;
+    using DateRange = std::pair<std::string, std::string>;  // РРРРММДД, межі включно
+
+    Queue& queue;
+    std::map<NamePair, std::set<std::string>> companiesByWasteDate;
+    std::map<NamePair, CostReport> costByCompanyWaste;
+    std::map<PhysicalState, std::set<std::string>> companiesByState;
+    std::map<std::string, std::map<DateRange, QuantityReport>> quantityByCompany;
+    std::size_t entryCount = 0;
+
+    void reserveEntry();
+    void invalidateRecord(const WasteRecord& record);
+    template<typename Map, typename Key>
+    void eraseEntry(Map& map, const Key& key);
+    void adjustQuantityEntries(const WasteRecord& record, int direction);
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "reports.h"
+
+#include "metrics.h"
+
+#include <iostream>
+#include <stdexcept>
+
+std::set<std::string> companiesByWasteAndDate(const Queue& queue, const std::string& wasteName,
+                                              const std::string& removalDate) {
+    ILONA_TIME_OPERATION(MetricOperation::ReportCompaniesByWasteAndDate);
+    std::set<std::string> foundCompanies;
+    const WasteNode* current = queue.head;
+    while (current != nullptr) {
+        if (current->data.wasteName == wasteName && current->data.removalDate == removalDate) {
+            foundCompanies.insert(current->data.companyName);
+        }
+        current = current->next;
+    }
+    return foundCompanies;
+}
+
+CostReport costByCompanyAndWaste(const Queue& queue, const std::string& companyName, const std::string& wasteName) {
+    ILONA_TIME_OPERATION(MetricOperation::ReportServiceCost);
+    CostReport report;
+    const WasteNode* current = queue.head;
+    while (current != nullptr) {
+        if (current->data.companyName == companyName && current->data.wasteName == wasteName) {
+            report.totalCost += current->data.cost;
+            ++report.matchedRecords;
+        }
+        current = current->next;
+    }
+    return report;
+}
+
+std::set<std::string> companiesByPhysicalState(const Queue& queue, const PhysicalState state) {
+    ILONA_TIME_OPERATION(MetricOperation::ReportCompaniesByPhysicalState);
+    std::set<std::string> foundCompanies;
+    const WasteNode* current = queue.head;
+    while (current != nullptr) {
+        if (current->data.state == state) {
+            foundCompanies.insert(current->data.companyName);
+        }
+        current = current->next;
+    }
+    return foundCompanies;
+}
+
+QuantityReport quantityByCompanyAndDateRange(const Queue& queue, const std::string& companyName,
+                                             const std::string& startDate, const std::string& endDate) {
+    const std::string comparableStartDate = convertDateToComparableFormat(startDate);
+    const std::string comparableEndDate = convertDateToComparableFormat(endDate);
+    if (comparableStartDate > comparableEndDate) {
+        throw std::invalid_argument("початкова дата (" + startDate + ") не може бути пізніше кінцевої дати (" + endDate + ").");
+    }
+
+    ILONA_TIME_OPERATION(MetricOperation::ReportWasteCountByDateRange);
+    QuantityReport report;
+    const WasteNode* current = queue.head;
+    while (current != nullptr) {
+        if (current->data.companyName == companyName) {
+            std::string recordDateComparable;
+            try {
+                recordDateComparable = convertDateToComparableFormat(current->data.removalDate);
+            } catch (const std::invalid_argument&) {
+                std::cerr << "Попередження: некоректна дата в записі для '" << current->data.companyName << "': " << current->data.removalDate << ". Запис пропущено.\n";
+                current = current->next;
+                continue;
+            }
+
+            if (recordDateComparable >= comparableStartDate && recordDateComparable <= comparableEndDate) {
+                report.totalQuantity += current->data.quantity;
+                ++report.matchedRecords;
+            }
+        }
+        current = current->next;
+    }
+    return report;
+}
+
+std::vector<WasteNode*> findRecordsByCompany(Queue& queue, const std::string& companyName) {
+    std::vector<WasteNode*> matchingNodes;
+    WasteNode* current = queue.head;
+    while (current != nullptr) {
+        if (current->data.companyName == companyName) {
+            matchingNodes.push_back(current);
+        }
+        current = current->next;
+    }
+    return matchingNodes;
+}
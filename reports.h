@@ -0,0 +1,38 @@
+#ifndef ILONA_REPORTS_H
+#define ILONA_REPORTS_H
+
+#include "waste_queue.h"
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+// Звіти без діалогу з користувачем: параметри передаються аргументами,
+// результат повертається значенням. Інтерактивне меню лише викликає їх.
+
+struct CostReport {
+    double totalCost = 0.0;
+    std::size_t matchedRecords = 0;
+};
+
+struct QuantityReport {
+    long long totalQuantity = 0;
+    std::size_t matchedRecords = 0;
+};
+
+std::set<std::string> companiesByWasteAndDate(const Queue& queue, const std::string& wasteName,
+                                              const std::string& removalDate);
+
+CostReport costByCompanyAndWaste(const Queue& queue, const std::string& companyName, const std::string& wasteName);
+
+std::set<std::string> companiesByPhysicalState(const Queue& queue, PhysicalState state);
+
+// Дати у форматі ДД:ММ:РРРР, межі включно.
+// Кидає std::invalid_argument, якщо формат дати неправильний або початкова дата пізніше кінцевої.
+QuantityReport quantityByCompanyAndDateRange(const Queue& queue, const std::string& companyName,
+                                             const std::string& startDate, const std::string& endDate);
+
+std::vector<WasteNode*> findRecordsByCompany(Queue& queue, const std::string& companyName);
+
+#endif
@@ -0,0 +1,356 @@
+#include "search_index.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr char32_t TRIGRAM_START = 0x02;
+constexpr char32_t TRIGRAM_END = 0x03;
+
+// Декодує наступний символ UTF-8; некоректний байт повертається як є.
+char32_t nextCodePoint(const std::string& text, std::size_t& position) {
+    const unsigned char lead = static_cast<unsigned char>(text[position]);
+    std::size_t length;
+    char32_t codePoint;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        codePoint = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        codePoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        codePoint = lead & 0x07;
+    } else {
+        ++position;
+        return lead;
+    }
+    if (position + length > text.size()) {
+        ++position;
+        return lead;
+    }
+    for (std::size_t i = 1; i < length; ++i) {
+        const unsigned char continuation = static_cast<unsigned char>(text[position + i]);
+        if ((continuation & 0xC0) != 0x80) {
+            ++position;
+            return lead;
+        }
+        codePoint = (codePoint << 6) | (continuation & 0x3F);
+    }
+    position += length;
+    return codePoint;
+}
+
+char32_t foldCodePoint(const char32_t c) {
+    if (c >= U'A' && c <= U'Z') return c + 0x20;
+    if (c >= 0x0410 && c <= 0x042F) return c + 0x20;  // А-Я
+    if (c >= 0x0400 && c <= 0x040F) return c + 0x50;  // Ѐ-Џ, зокрема Є, І, Ї
+    if (c == 0x0490) return 0x0491;                   // Ґ
+    if (c == 0x2019 || c == 0x02BC || c == 0x0060) return U'\'';
+    return c;
+}
+
+bool isIgnoredQuote(const char32_t c) {
+    return c == U'"' || c == 0x00AB || c == 0x00BB || c == 0x201C || c == 0x201D || c == 0x201E;
+}
+
+bool isSpace(const char32_t c) {
+    return c == U' ' || c == U'\t' || c == U'\r' || c == U'\n' || c == 0x00A0;
+}
+
+std::vector<std::uint64_t> trigramsOf(const std::u32string& folded) {
+    std::u32string padded;
+    padded.reserve(folded.size() + 3);
+    padded.push_back(TRIGRAM_START);
+    padded.push_back(TRIGRAM_START);
+    padded.append(folded);
+    padded.push_back(TRIGRAM_END);
+
+    std::vector<std::uint64_t> trigrams;
+    trigrams.reserve(padded.size());
+    for (std::size_t i = 0; i + 2 < padded.size(); ++i) {
+        trigrams.push_back((static_cast<std::uint64_t>(padded[i]) << 42) |
+                           (static_cast<std::uint64_t>(padded[i + 1]) << 21) |
+                           static_cast<std::uint64_t>(padded[i + 2]));
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+} // namespace
+
+std::u32string foldNameForSearch(const std::string& name) {
+    std::u32string folded;
+    folded.reserve(name.size());
+    bool pendingSpace = false;
+    std::size_t position = 0;
+    while (position < name.size()) {
+        const char32_t c = foldCodePoint(nextCodePoint(name, position));
+        if (isIgnoredQuote(c)) {
+            continue;
+        }
+        if (isSpace(c)) {
+            pendingSpace = !folded.empty();
+            continue;
+        }
+        if (pendingSpace) {
+            folded.push_back(U' ');
+            pendingSpace = false;
+        }
+        folded.push_back(c);
+    }
+    return folded;
+}
+
+void NameSearchIndex::add(const std::string& name) {
+    const auto it = names.find(name);
+    if (it != names.end()) {
+        ++it->second.references;
+        return;
+    }
+    const std::uint32_t keyId = acquireKey(foldNameForSearch(name));
+    keys[keyId].originals.push_back(name);
+    names.emplace(name, NameEntry{ 1, keyId });
+}
+
+void NameSearchIndex::remove(const std::string& name) {
+    const auto it = names.find(name);
+    if (it == names.end() || --it->second.references > 0) {
+        return;
+    }
+    const std::uint32_t keyId = it->second.keyId;
+    names.erase(it);
+
+    std::vector<std::string>& originals = keys[keyId].originals;
+    originals.erase(std::find(originals.begin(), originals.end(), name));
+    if (originals.empty()) {
+        releaseKey(keyId);
+    }
+}
+
+void NameSearchIndex::clear() {
+    names.clear();
+    keyIdsByFolded.clear();
+    keys.clear();
+    freeKeyIds.clear();
+    trie.assign(1, TrieNode());
+    trigramPostings.clear();
+}
+
+bool NameSearchIndex::contains(const std::string& name) const {
+    return names.find(name) != names.end();
+}
+
+std::uint32_t NameSearchIndex::acquireKey(const std::u32string& folded) {
+    const auto existing = keyIdsByFolded.find(folded);
+    if (existing != keyIdsByFolded.end()) {
+        return existing->second;
+    }
+
+    std::uint32_t keyId;
+    if (!freeKeyIds.empty()) {
+        keyId = freeKeyIds.back();
+        freeKeyIds.pop_back();
+    } else {
+        keyId = static_cast<std::uint32_t>(keys.size());
+        keys.emplace_back();
+    }
+    keyIdsByFolded.emplace(folded, keyId);
+
+    std::uint32_t node = 0;
+    for (const char32_t c : folded) {
+        auto& children = trie[node].children;
+        const auto child = std::lower_bound(children.begin(), children.end(), c,
+            [](const std::pair<char32_t, std::uint32_t>& entry, const char32_t value) { return entry.first < value; });
+        if (child != children.end() && child->first == c) {
+            node = child->second;
+            continue;
+        }
+        const std::uint32_t created = static_cast<std::uint32_t>(trie.size());
+        children.insert(child, { c, created });
+        trie.emplace_back();
+        node = created;
+    }
+    trie[node].keyId = keyId;
+
+    const std::vector<std::uint64_t> trigrams = trigramsOf(folded);
+    for (const std::uint64_t trigram : trigrams) {
+        trigramPostings[trigram].push_back(keyId);
+    }
+    keys[keyId].folded = folded;
+    keys[keyId].trigramCount = static_cast<std::uint32_t>(trigrams.size());
+    return keyId;
+}
+
+// Вузли дерева не видаляються: звільнений ключ лише знімає позначку кінця назви.
+void NameSearchIndex::releaseKey(const std::uint32_t keyId) {
+    FoldedKey& key = keys[keyId];
+    const std::int64_t node = findTrieNode(key.folded);
+    if (node >= 0) {
+        trie[static_cast<std::size_t>(node)].keyId = -1;
+    }
+    for (const std::uint64_t trigram : trigramsOf(key.folded)) {
+        const auto posting = trigramPostings.find(trigram);
+        if (posting == trigramPostings.end()) {
+            continue;
+        }
+        std::vector<std::uint32_t>& ids = posting->second;
+        const auto position = std::find(ids.begin(), ids.end(), keyId);
+        if (position != ids.end()) {
+            *position = ids.back();
+            ids.pop_back();
+        }
+        if (ids.empty()) {
+            trigramPostings.erase(posting);
+        }
+    }
+    keyIdsByFolded.erase(key.folded);
+    key = FoldedKey();
+    freeKeyIds.push_back(keyId);
+}
+
+std::int64_t NameSearchIndex::findTrieNode(const std::u32string& folded) const {
+    std::uint32_t node = 0;
+    for (const char32_t c : folded) {
+        const auto& children = trie[node].children;
+        const auto child = std::lower_bound(children.begin(), children.end(), c,
+            [](const std::pair<char32_t, std::uint32_t>& entry, const char32_t value) { return entry.first < value; });
+        if (child == children.end() || child->first != c) {
+            return -1;
+        }
+        node = child->second;
+    }
+    return node;
+}
+
+void NameSearchIndex::appendOriginals(const std::uint32_t keyId, const std::size_t limit,
+                                      std::vector<std::string>& out) const {
+    for (const std::string& original : keys[keyId].originals) {
+        if (out.size() >= limit) {
+            return;
+        }
+        out.push_back(original);
+    }
+}
+
+std::vector<std::string> NameSearchIndex::findByPrefix(const std::string& prefix, const std::size_t limit) const {
+    std::vector<std::string> found;
+    const std::int64_t start = findTrieNode(foldNameForSearch(prefix));
+    if (start < 0 || limit == 0) {
+        return found;
+    }
+
+    // Обхід у прямому порядку дає назви в лексикографічному порядку згорнутої форми.
+    std::vector<std::uint32_t> pending{ static_cast<std::uint32_t>(start) };
+    while (!pending.empty() && found.size() < limit) {
+        const TrieNode& node = trie[pending.back()];
+        pending.pop_back();
+        if (node.keyId >= 0) {
+            appendOriginals(static_cast<std::uint32_t>(node.keyId), limit, found);
+        }
+        for (auto child = node.children.rbegin(); child != node.children.rend(); ++child) {
+            pending.push_back(child->second);
+        }
+    }
+    return found;
+}
+
+std::vector<std::string> NameSearchIndex::findSimilar(const std::string& query, const std::size_t limit,
+                                                      const double minSimilarity) const {
+    std::vector<std::string> found;
+    const std::vector<std::uint64_t> queryTrigrams = trigramsOf(foldNameForSearch(query));
+    if (queryTrigrams.empty() || limit == 0) {
+        return found;
+    }
+
+    std::vector<std::uint32_t> sharedTrigrams(keys.size(), 0);
+    std::vector<std::uint32_t> candidates;
+    for (const std::uint64_t trigram : queryTrigrams) {
+        const auto posting = trigramPostings.find(trigram);
+        if (posting == trigramPostings.end()) {
+            continue;
+        }
+        for (const std::uint32_t keyId : posting->second) {
+            if (sharedTrigrams[keyId]++ == 0) {
+                candidates.push_back(keyId);
+            }
+        }
+    }
+
+    std::vector<std::pair<double, std::uint32_t>> scored;
+    for (const std::uint32_t keyId : candidates) {
+        const double similarity = 2.0 * sharedTrigrams[keyId] /
+            static_cast<double>(queryTrigrams.size() + keys[keyId].trigramCount);
+        if (similarity >= minSimilarity) {
+            scored.emplace_back(similarity, keyId);
+        }
+    }
+    std::sort(scored.begin(), scored.end(), [this](const auto& left, const auto& right) {
+        if (left.first != right.first) {
+            return left.first > right.first;
+        }
+        return keys[left.second].folded < keys[right.second].folded;
+    });
+
+    for (const auto& candidate : scored) {
+        if (found.size() >= limit) {
+            break;
+        }
+        appendOriginals(candidate.second, limit, found);
+    }
+    return found;
+}
+
+std::vector<std::string> NameSearchIndex::suggest(const std::string& query, const std::size_t limit) const {
+    std::vector<std::string> found = findByPrefix(query, limit);
+    if (found.size() >= limit) {
+        return found;
+    }
+    for (std::string& similar : findSimilar(query, limit + found.size())) {
+        if (found.size() >= limit) {
+            break;
+        }
+        if (std::find(found.begin(), found.end(), similar) == found.end()) {
+            found.push_back(std::move(similar));
+        }
+    }
+    return found;
+}
+
+QueueSearchIndex::QueueSearchIndex(Queue& queue) : queue(queue) {
+    for (const WasteNode* current = queue.head; current != nullptr; current = current->next) {
+        onRecordAdded(*current);
+    }
+    addQueueListener(queue, this);
+}
+
+QueueSearchIndex::~QueueSearchIndex() {
+    removeQueueListener(queue, this);
+}
+
+void QueueSearchIndex::onRecordAdded(const WasteNode& node) {
+    companyNames.add(node.data.companyName);
+    wasteNames.add(node.data.wasteName);
+}
+
+void QueueSearchIndex::onRecordRemoved(const WasteNode& node) {
+    companyNames.remove(node.data.companyName);
+    wasteNames.remove(node.data.wasteName);
+}
+
+void QueueSearchIndex::onRecordUpdated(const WasteNode& node, const WasteRecord& previous) {
+    if (node.data.companyName != previous.companyName) {
+        companyNames.remove(previous.companyName);
+        companyNames.add(node.data.companyName);
+    }
+    if (node.data.wasteName != previous.wasteName) {
+        wasteNames.remove(previous.wasteName);
+        wasteNames.add(node.data.wasteName);
+    }
+}
+
+void QueueSearchIndex::onQueueCleared() {
+    companyNames.clear();
+    wasteNames.clear();
+}
@@ -0,0 +1,89 @@
+#ifndef ILONA_SEARCH_INDEX_H
+#define ILONA_SEARCH_INDEX_H
+
+#include "waste_queue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Приводить назву до форми для пошуку: нижній регістр для латиниці та кирилиці
+// (включно з є, і, ї, ґ), уніфіковані апострофи, без лапок, одинарні пробіли.
+std::u32string foldNameForSearch(const std::string& name);
+
+// Індекс різних назв (підприємств або відходів) із підрахунком посилань.
+// Префіксний пошук - через префіксне дерево за згорнутими символами,
+// нечіткий - за триграмами з мірою подібності Дайса.
+class NameSearchIndex {
+public:
+    void add(const std::string& name);
+    void remove(const std::string& name);
+    void clear();
+
+    bool contains(const std::string& name) const;
+    std::size_t distinctNames() const { return names.size(); }
+
+    std::vector<std::string> findByPrefix(const std::string& prefix, std::size_t limit) const;
+    std::vector<std::string> findSimilar(const std::string& query, std::size_t limit,
+                                         double minSimilarity = 0.3) const;
+    // Спочатку збіги за префіксом (точний збіг без урахування регістру - першим), далі схожі назви.
+    std::vector<std::string> suggest(const std::string& query, std::size_t limit) const;
+
+private:
+    struct NameEntry {
+        std::size_t references;
+        std::uint32_t keyId;
+    };
+
+    // Кілька написань можуть згортатися в один ключ ("ЕкоСервіс" і "екосервіс").
+    struct FoldedKey {
+        std::u32string folded;
+        std::vector<std::string> originals;
+        std::uint32_t trigramCount = 0;
+    };
+
+    struct TrieNode {
+        std::vector<std::pair<char32_t, std::uint32_t>> children;  // упорядковано за символом
+        std::int64_t keyId = -1;
+    };
+
+    std::unordered_map<std::string, NameEntry> names;
+    std::unordered_map<std::u32string, std::uint32_t> keyIdsByFolded;
+    std::vector<FoldedKey> keys;
+    std::vector<std::uint32_t> freeKeyIds;
+    std::vector<TrieNode> trie = std::vector<TrieNode>(1);
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> trigramPostings;
+
+    std::uint32_t acquireKey(const std::u32string& folded);
+    void releaseKey(std::uint32_t keyId);
+    std::int64_t findTrieNode(const std::u32string& folded) const;
+    void appendOriginals(std::uint32_t keyId, std::size_t limit, std::vector<std::string>& out) const;
+};
+
+// Індекси назв підприємств і відходів, які оновлюються разом із чергою.
+// Черга має жити довше за індекс.
+class QueueSearchIndex : public QueueListener {
+public:
+    explicit QueueSearchIndex(Queue& queue);
+    ~QueueSearchIndex() override;
+
+    QueueSearchIndex(const QueueSearchIndex&) = delete;
+    QueueSearchIndex& operator=(const QueueSearchIndex&) = delete;
+
+    const NameSearchIndex& companies() const { return companyNames; }
+    const NameSearchIndex& wastes() const { return wasteNames; }
+
+    void onRecordAdded(const WasteNode& node) override;
+    void onRecordRemoved(const WasteNode& node) override;
+    void onRecordUpdated(const WasteNode& node, const WasteRecord& previous) override;
+    void onQueueCleared() override;
+
+private:
+    Queue& queue;
+    NameSearchIndex companyNames;
+    NameSearchIndex wasteNames;
+};
+
+#endif
@@ -0,0 +1,434 @@
+#include "ilona.h"
+#include "protocol.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <unordered_map>
+
+// Сервер черги: ilona_server [--port N | --unix ШЛЯХ] [--load ФАЙЛ] [--save ФАЙЛ]
+// Тримає чергу в пам'яті й обслуговує клієнтів протоколу з protocol.h; з --save
+// після зупинки (SIGINT/SIGTERM) черга записується у файл, інакше зміни втрачаються.
+// Один потік, epoll і неблокувальні сокети: усі повні кадри, прочитані за раз,
+// виконуються пакетом, а відповіді на них надсилаються одним записом.
+// За одну подію читається не більше MAX_READ_PER_EVENT байтів, а нові кадри не
+// виконуються, доки в буфері відповідей є MAX_PENDING_OUTPUT байтів: решта запитів
+// чекає в буфері вводу, поки клієнт не прочитає відповіді. Коли клієнт закриває свій
+// бік з'єднання, уже надіслані ним запити виконуються, а відповіді дописуються до кінця.
+
+namespace {
+
+constexpr int DEFAULT_PORT = 7878;
+constexpr int MAX_EVENTS = 256;
+constexpr std::size_t READ_CHUNK_SIZE = 64 * 1024;
+// Обмежує і ріст буфера вводу, і час, який одне з'єднання забирає в інших.
+constexpr std::size_t MAX_READ_PER_EVENT = 16 * READ_CHUNK_SIZE;
+// Клієнт, що не читає відповіді, перестає обслуговуватись, доки буфер не спорожніє.
+constexpr std::size_t MAX_PENDING_OUTPUT = 8 * 1024 * 1024;
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void onStopSignal(int) {
+    stopRequested = 1;
+}
+
+struct Connection {
+    int fd = -1;
+    std::string input;
+    std::string output;
+    std::size_t outputOffset = 0;
+    std::uint32_t events = 0;
+    // Клієнт закрив свій бік: нових запитів не буде, лишилося надіслати відповіді.
+    bool peerClosed = false;
+};
+
+bool setNonBlocking(const int fd) {
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
+int createTcpListener(const int port) {
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd == -1) {
+        return -1;
+    }
+    const int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 || listen(fd, SOMAXCONN) == -1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Прибирає сокет, що лишився від попереднього запуску. Інший файл за цим шляхом
+// не чіпає: повертає false з errno = EEXIST.
+bool removeStaleSocket(const std::string& path) {
+    struct stat info{};
+    if (lstat(path.c_str(), &info) == -1) {
+        return errno == ENOENT;
+    }
+    if (!S_ISSOCK(info.st_mode)) {
+        errno = EEXIST;
+        return false;
+    }
+    return unlink(path.c_str()) == 0 || errno == ENOENT;
+}
+
+int createUnixListener(const std::string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    if (!removeStaleSocket(path)) {
+        return -1;
+    }
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) {
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 || listen(fd, SOMAXCONN) == -1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+class QueueServer {
+public:
+    QueueServer(Queue& queue, const int listenFd)
+        : reportCache(queue), pickupView(queue), context{ queue, reportCache, pickupView }, listenFd(listenFd) {}
+
+    ~QueueServer() {
+        for (auto& entry : connections) {
+            close(entry.first);
+        }
+        if (epollFd != -1) {
+            close(epollFd);
+        }
+    }
+
+    bool run() {
+        epollFd = epoll_create1(0);
+        if (epollFd == -1 || !setNonBlocking(listenFd)) {
+            return false;
+        }
+        epoll_event listenEvent{};
+        listenEvent.events = EPOLLIN;
+        listenEvent.data.fd = listenFd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent) == -1) {
+            return false;
+        }
+
+        epoll_event events[MAX_EVENTS];
+        while (!stopRequested) {
+            const int ready = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+            if (ready == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            for (int i = 0; i < ready; ++i) {
+                if (events[i].data.fd == listenFd) {
+                    acceptConnections();
+                } else {
+                    handleConnectionEvent(events[i].data.fd, events[i].events);
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    ReportCache reportCache;
+    PickupPriorityView pickupView;
+    ProtocolContext context;
+    int listenFd;
+    int epollFd = -1;
+    std::unordered_map<int, Connection> connections;
+
+    void acceptConnections() {
+        while (true) {
+            const int fd = accept(listenFd, nullptr, nullptr);
+            if (fd == -1) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    std::cerr << "Помилка accept: " << std::strerror(errno) << "\n";
+                }
+                return;
+            }
+            if (!setNonBlocking(fd)) {
+                close(fd);
+                continue;
+            }
+            // Для TCP відповіді не мають чекати алгоритму Нейгла; для Unix-сокетів виклик просто не спрацює.
+            const int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+            Connection& connection = connections[fd];
+            connection.fd = fd;
+            connection.events = EPOLLIN;
+            epoll_event event{};
+            event.events = connection.events;
+            event.data.fd = fd;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1) {
+                closeConnection(fd);
+            }
+        }
+    }
+
+    void handleConnectionEvent(const int fd, const std::uint32_t events) {
+        const auto it = connections.find(fd);
+        if (it == connections.end()) {
+            return;
+        }
+        Connection& connection = it->second;
+
+        if (events & (EPOLLERR | EPOLLHUP)) {
+            if (!(events & EPOLLIN)) {
+                closeConnection(fd);
+                return;
+            }
+        }
+        if ((events & EPOLLIN) && !connection.peerClosed && !readInput(connection)) {
+            closeConnection(fd);
+            return;
+        }
+        // Поки відповіді встигають відправлятися, виконуються і кадри, що лишилися з
+        // попередніх подій: нових даних від клієнта для них може й не надійти.
+        while (true) {
+            if (!processFrames(connection) || !flushOutput(connection)) {
+                closeConnection(fd);
+                return;
+            }
+            if (pendingOutput(connection) >= MAX_PENDING_OUTPUT || !hasCompleteFrame(connection)) {
+                break;
+            }
+        }
+        if (connection.peerClosed && pendingOutput(connection) == 0 && !hasCompleteFrame(connection)) {
+            // Усі відповіді надіслано; неповний кадр у вводі вже не допишеться.
+            closeConnection(fd);
+            return;
+        }
+        updateInterest(connection);
+    }
+
+    static std::size_t pendingOutput(const Connection& connection) {
+        return connection.output.size() - connection.outputOffset;
+    }
+
+    static bool hasCompleteFrame(const Connection& connection) {
+        std::size_t offset = 0;
+        const char* payload = nullptr;
+        std::size_t payloadSize = 0;
+        try {
+            return nextFrame(connection.input, offset, payload, payloadSize);
+        } catch (const ProtocolError&) {
+            // Помилку кадру повідомить processFrames.
+            return true;
+        }
+    }
+
+    // Читає доступні дані, але не більше MAX_READ_PER_EVENT байтів: решту повідомить
+    // наступна подія epoll. false - з'єднання треба закрити.
+    bool readInput(Connection& connection) {
+        char buffer[READ_CHUNK_SIZE];
+        std::size_t receivedTotal = 0;
+        while (receivedTotal < MAX_READ_PER_EVENT) {
+            const ssize_t received = read(connection.fd, buffer, sizeof(buffer));
+            if (received > 0) {
+                connection.input.append(buffer, static_cast<std::size_t>(received));
+                receivedTotal += static_cast<std::size_t>(received);
+                continue;
+            }
+            if (received == 0) {
+                connection.peerClosed = true;
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    // Виконує повні кадри з буфера вводу, доки буфер відповідей не заповниться;
+    // невиконані кадри лишаються у вводі. false - з'єднання треба закрити.
+    bool processFrames(Connection& connection) {
+        std::size_t offset = 0;
+        const char* payload = nullptr;
+        std::size_t payloadSize = 0;
+        try {
+            while (pendingOutput(connection) < MAX_PENDING_OUTPUT &&
+                   nextFrame(connection.input, offset, payload, payloadSize)) {
+                handleProtocolRequest(context, payload, payloadSize, connection.output);
+            }
+        } catch (const ProtocolError& ex) {
+            std::cerr << "З'єднання " << connection.fd << " закрито: " << ex.what() << "\n";
+            return false;
+        }
+        connection.input.erase(0, offset);
+        return true;
+    }
+
+    bool flushOutput(Connection& connection) {
+        while (connection.outputOffset < connection.output.size()) {
+            const ssize_t sent = send(connection.fd, connection.output.data() + connection.outputOffset,
+                                      connection.output.size() - connection.outputOffset, MSG_NOSIGNAL);
+            if (sent > 0) {
+                connection.outputOffset += static_cast<std::size_t>(sent);
+                continue;
+            }
+            if (sent == -1 && errno == EINTR) {
+                continue;
+            }
+            if (sent == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            return false;
+        }
+        if (connection.outputOffset == connection.output.size()) {
+            connection.output.clear();
+            connection.outputOffset = 0;
+        } else if (connection.outputOffset > MAX_PENDING_OUTPUT / 2) {
+            connection.output.erase(0, connection.outputOffset);
+            connection.outputOffset = 0;
+        }
+        return true;
+    }
+
+    void updateInterest(Connection& connection) {
+        const std::size_t pending = pendingOutput(connection);
+        std::uint32_t wanted = 0;
+        // Після закриття клієнтом EPOLLIN спрацьовував би постійно (кінець потоку).
+        if (pending < MAX_PENDING_OUTPUT && !connection.peerClosed) {
+            wanted |= EPOLLIN;
+        }
+        if (pending > 0) {
+            wanted |= EPOLLOUT;
+        }
+        if (wanted == connection.events) {
+            return;
+        }
+        connection.events = wanted;
+        epoll_event event{};
+        event.events = wanted;
+        event.data.fd = connection.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+    }
+
+    void closeConnection(const int fd) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int port = DEFAULT_PORT;
+    std::string unixPath;
+    std::string loadFile;
+    std::string saveFile;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        try {
+            if (argument == "--port" && i + 1 < argc) {
+                port = std::stoi(argv[++i]);
+                if (port < 1 || port > 65535) {
+                    throw std::out_of_range("port");
+                }
+            } else if (argument == "--unix" && i + 1 < argc) {
+                unixPath = argv[++i];
+            } else if (argument == "--load" && i + 1 < argc) {
+                loadFile = argv[++i];
+            } else if (argument == "--save" && i + 1 < argc) {
+                saveFile = argv[++i];
+            } else {
+                throw std::invalid_argument(argument);
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Використання: " << argv[0] << " [--port N | --unix ШЛЯХ] [--load ФАЙЛ] [--save ФАЙЛ]\n";
+            return 1;
+        }
+    }
+
+    Queue queue;
+    if (!loadFile.empty()) {
+        if (!loadQueueFromFile(queue, loadFile)) {
+            std::cerr << "Не вдалося завантажити файл: " << loadFile << "\n";
+            return 1;
+        }
+        std::cout << "Завантажено записів: " << queue.size << "\n";
+    }
+
+    const int listenFd = unixPath.empty() ? createTcpListener(port) : createUnixListener(unixPath);
+    if (listenFd == -1) {
+        std::cerr << "Не вдалося відкрити сокет: " << std::strerror(errno) << "\n";
+        clearQueue(queue);
+        return 1;
+    }
+
+    struct sigaction action{};
+    action.sa_handler = onStopSignal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    if (unixPath.empty()) {
+        std::cout << "Сервер слухає 127.0.0.1:" << port << "\n";
+    } else {
+        std::cout << "Сервер слухає " << unixPath << "\n";
+    }
+    std::cout.flush();
+
+    bool ok;
+    {
+        QueueServer server(queue, listenFd);
+        ok = server.run();
+        if (!ok) {
+            std::cerr << "Помилка циклу подій: " << std::strerror(errno) << "\n";
+        }
+    }
+    close(listenFd);
+    if (!unixPath.empty() && !removeStaleSocket(unixPath)) {
+        std::cerr << "Не вдалося видалити сокет " << unixPath << ": " << std::strerror(errno) << "\n";
+    }
+
+    std::cout << "Сервер зупинено. Записів у черзі: " << queue.size << "\n";
+    if (!saveFile.empty()) {
+        if (saveQueueToFile(queue, saveFile)) {
+            std::cout << "Чергу збережено у файл: " << saveFile << "\n";
+        } else {
+            std::cerr << "Не вдалося зберегти чергу у файл: " << saveFile << "\n";
+            ok = false;
+        }
+    }
+    clearQueue(queue);
+    return ok ? 0 : 1;
+}
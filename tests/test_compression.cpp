@@ -0,0 +1,149 @@
+#include "compression.h"
+#include "test_support.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void putLittleEndian32(std::string& bytes, const std::size_t position, const std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        bytes[position + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+std::uint32_t getLittleEndian32(const std::string& bytes, const std::size_t position) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[position + i])) << (8 * i);
+    }
+    return value;
+}
+
+std::string pseudoRandomBytes(const std::size_t size) {
+    std::string bytes(size, '\0');
+    std::uint32_t state = 12345;
+    for (char& byte : bytes) {
+        state = state * 1103515245u + 12345u;
+        byte = static_cast<char>(state >> 24);
+    }
+    return bytes;
+}
+
+void checkRoundTrip(const std::string& input) {
+    const std::string compressed = lz4CompressBlock(input);
+    CHECK(lz4DecompressBlock(compressed.data(), compressed.size(), input.size()) == input);
+}
+
+void testLz4RoundTrip() {
+    checkRoundTrip("");
+    checkRoundTrip("abc");
+    checkRoundTrip(std::string(100000, 'x'));
+    checkRoundTrip(pseudoRandomBytes(65536));
+
+    std::string records;
+    for (int i = 0; i < 2000; ++i) {
+        records += "ТОВ Екосервіс\nвул. Промислова, " + std::to_string(i % 37) + "\n---END_RECORD---\n";
+    }
+    checkRoundTrip(records);
+    CHECK(lz4CompressBlock(records).size() < records.size() / 4);
+}
+
+void testLz4RejectsCorruptBlocks() {
+    const std::string input(5000, 'a');
+    const std::string compressed = lz4CompressBlock(input);
+
+    CHECK_THROWS(std::runtime_error, lz4DecompressBlock(compressed.data(), compressed.size(), input.size() - 1));
+    CHECK_THROWS(std::runtime_error, lz4DecompressBlock(compressed.data(), compressed.size(), input.size() + 1));
+    CHECK_THROWS(std::runtime_error, lz4DecompressBlock(compressed.data(), compressed.size() - 1, input.size()));
+
+    // Токен без літералів і нульове зміщення збігу.
+    const std::string zeroOffset("\x00\x00\x00", 3);
+    CHECK_THROWS(std::runtime_error, lz4DecompressBlock(zeroOffset.data(), zeroOffset.size(), 4));
+    // Зміщення вказує перед початок виводу.
+    const std::string farOffset("\x10" "a" "\x05\x00", 4);
+    CHECK_THROWS(std::runtime_error, lz4DecompressBlock(farOffset.data(), farOffset.size(), 5));
+}
+
+void writeContainer(const std::string& path, const std::string& first, const std::string& second) {
+    BlockFileWriter writer(path);
+    CHECK(writer.isOpen());
+    writer.addBlock(first, 3);
+    writer.addBlock(second, 5);
+    CHECK(writer.finish());
+}
+
+void testContainerRoundTrip() {
+    const TempFile file("ilona_test_container.iwz");
+    const std::string first(70000, 'q');
+    const std::string second = pseudoRandomBytes(4096);
+    writeContainer(file.path(), first, second);
+
+    CHECK(isBlockContainerFile(file.path()));
+    BlockFileReader reader(file.path());
+    CHECK(reader.blockCount() == 2);
+    CHECK(reader.blockInfo(0).recordCount == 3);
+    CHECK(reader.blockInfo(0).codec == BlockCodec::LZ4);
+    CHECK(reader.blockInfo(1).codec == BlockCodec::Raw);
+    CHECK(reader.readBlock(1) == second);
+    CHECK(reader.readBlock(0) == first);
+
+    const TempFile text("ilona_test_container.txt");
+    text.write("abc\n---END_RECORD---\n");
+    CHECK(!isBlockContainerFile(text.path()));
+}
+
+void testContainerRejectsCorruptFooter() {
+    const TempFile file("ilona_test_corrupt.iwz");
+    writeContainer(file.path(), std::string(70000, 'q'), "short block");
+    const std::string original = file.read();
+    const std::size_t footer = original.size() - 16;
+    const std::size_t indexOffset = footer - 2 * 25;
+
+    // Кількість блоків, за якої таблиця не вміщується у файл (і множення переповнилося б).
+    std::string bytes = original;
+    putLittleEndian32(bytes, footer, 0xFFFFFFFFu);
+    file.write(bytes);
+    CHECK_THROWS(std::runtime_error, BlockFileReader reader(file.path()));
+
+    // Кількість блоків, що не збігається зі зміщенням таблиці.
+    bytes = original;
+    putLittleEndian32(bytes, footer, 1);
+    file.write(bytes);
+    CHECK_THROWS(std::runtime_error, BlockFileReader reader(file.path()));
+
+    // Розпакований розмір більший, ніж може дати LZ4 із такого стиснутого блоку.
+    bytes = original;
+    const std::uint32_t compressedSize = getLittleEndian32(bytes, indexOffset + 8);
+    putLittleEndian32(bytes, indexOffset + 12, compressedSize * 255 + 1);
+    file.write(bytes);
+    CHECK_THROWS(std::runtime_error, BlockFileReader reader(file.path()));
+
+    // Блок виходить за межі області даних.
+    bytes = original;
+    putLittleEndian32(bytes, indexOffset + 8, 0x7FFFFFFFu);
+    file.write(bytes);
+    CHECK_THROWS(std::runtime_error, BlockFileReader reader(file.path()));
+
+    // Пошкоджені дані блоку виявляє контрольна сума.
+    bytes = original;
+    bytes[8 + 20] ^= 0x01;
+    file.write(bytes);
+    BlockFileReader reader(file.path());
+    CHECK_THROWS(std::runtime_error, reader.readBlock(0));
+
+    // Файл без кінцівки (запис не завершено).
+    file.write(original.substr(0, footer));
+    CHECK_THROWS(std::runtime_error, BlockFileReader reader(file.path()));
+}
+
+} // namespace
+
+int main() {
+    testLz4RoundTrip();
+    testLz4RejectsCorruptBlocks();
+    testContainerRoundTrip();
+    testContainerRejectsCorruptFooter();
+    return testExitCode();
+}
@@ -0,0 +1,136 @@
+#include "mapped_records.h"
+#include "test_support.h"
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+const char* COMPANIES[] = { "Альфа", "Бета", "Гама" };
+const char* WASTES[] = { "Оливи", "Шини", "Акумулятори" };
+const char* DATES[] = { "01:03:2023", "15:06:2023", "29:02:2024", "31:12:2022" };
+
+// Текстовий файл у форматі saveQueueToFile з навмисно зіпсованими записами:
+// некоректні дата, стан, кількість і вартість, а також неповні записи.
+std::string buildDataFile() {
+    std::ostringstream out;
+    for (int i = 0; i < 3000; ++i) {
+        std::string state = std::to_string(1 + i % 3);
+        std::string date = DATES[i % 4];
+        std::string quantity = std::to_string(1 + i % 9);
+        std::string cost = std::to_string(10 + i % 13) + ".25";
+        switch (i % 23) {
+        case 1: date = "31:02:2023"; break;
+        case 2: date = "1:03:2023"; break;
+        case 3: state = "9"; break;
+        case 4: state = "x"; break;
+        case 5: quantity = "багато"; break;
+        case 6: cost = ""; break;
+        case 7: quantity = " +7"; break;  // приймає і std::stoi
+        default: break;
+        }
+        out << "1000" << i % 10 << "\n"
+            << COMPANIES[i % 3] << "\n"
+            << "адреса " << i << "\n"
+            << "телефон\n"
+            << "W-0" << i % 3 << "\n"
+            << WASTES[(i / 3) % 3] << "\n"
+            << state << "\n";
+        if (i % 97 != 8) {  // неповний запис: без дати
+            out << date << "\n";
+        }
+        out << quantity << "\n" << cost << "\n---END_RECORD---\n";
+    }
+    return out.str();
+}
+
+bool sameRecord(const WasteRecord& left, const WasteRecord& right) {
+    return left.companyCode == right.companyCode && left.companyName == right.companyName &&
+        left.address == right.address && left.phone == right.phone && left.wasteCode == right.wasteCode &&
+        left.wasteName == right.wasteName && left.state == right.state && left.removalDate == right.removalDate &&
+        left.quantity == right.quantity && left.cost == right.cost;
+}
+
+void testReportsMatchEagerLoad() {
+    const TempFile file("ilona_test_mapped.txt");
+    file.write(buildDataFile());
+
+    Queue eager;
+    CHECK(loadQueueFromFile(eager, file.path()));
+
+    // Кожен звіт - на щойно відкритому файлі, щоб він не покладався на стовпці інших звітів.
+    for (const char* waste : WASTES) {
+        for (const char* date : DATES) {
+            MappedRecordFile lazy(file.path());
+            CHECK(companiesByWasteAndDate(lazy, waste, date) == companiesByWasteAndDate(eager, waste, date));
+        }
+    }
+    for (const char* company : COMPANIES) {
+        for (const char* waste : WASTES) {
+            MappedRecordFile lazy(file.path());
+            const CostReport lazyReport = costByCompanyAndWaste(lazy, company, waste);
+            const CostReport eagerReport = costByCompanyAndWaste(eager, company, waste);
+            CHECK(lazyReport.matchedRecords == eagerReport.matchedRecords);
+            CHECK(lazyReport.totalCost == eagerReport.totalCost);
+        }
+        MappedRecordFile lazy(file.path());
+        const QuantityReport lazyReport = quantityByCompanyAndDateRange(lazy, company, "01:01:2023", "31:12:2023");
+        const QuantityReport eagerReport = quantityByCompanyAndDateRange(eager, company, "01:01:2023", "31:12:2023");
+        CHECK(lazyReport.totalQuantity == eagerReport.totalQuantity);
+        CHECK(lazyReport.matchedRecords == eagerReport.matchedRecords);
+        CHECK_THROWS(std::invalid_argument, quantityByCompanyAndDateRange(lazy, company, "02:01:2023", "01:01:2023"));
+    }
+    for (const PhysicalState state : { PhysicalState::Solid, PhysicalState::Liquid, PhysicalState::Gas }) {
+        MappedRecordFile lazy(file.path());
+        CHECK(companiesByPhysicalState(lazy, state) == companiesByPhysicalState(eager, state));
+    }
+
+    // Окремі записи і materialize дають ті самі записи, що й звичайне завантаження.
+    MappedRecordFile lazy(file.path());
+    std::size_t validCount = 0;
+    const WasteNode* expected = eager.head;
+    bool sameRecords = true;
+    for (std::size_t i = 0; i < lazy.recordCount(); ++i) {
+        if (!lazy.isValidRecord(i)) {
+            CHECK_THROWS(std::invalid_argument, lazy.record(i));
+            continue;
+        }
+        ++validCount;
+        sameRecords = sameRecords && expected != nullptr && sameRecord(lazy.record(i), expected->data);
+        expected = expected != nullptr ? expected->next : nullptr;
+    }
+    CHECK(sameRecords);
+    CHECK(validCount == eager.size);
+    CHECK(lazy.skippedRecords() > 0);
+    CHECK(validCount < lazy.recordCount());
+
+    Queue materialized;
+    lazy.materialize(materialized);
+    CHECK(materialized.size == eager.size);
+    sameRecords = materialized.size == eager.size;
+    for (const WasteNode *left = materialized.head, *right = eager.head; sameRecords && left != nullptr;
+         left = left->next, right = right->next) {
+        sameRecords = sameRecord(left->data, right->data);
+    }
+    CHECK(sameRecords);
+
+    clearQueue(materialized);
+    clearQueue(eager);
+}
+
+void testRejectsBlockFiles() {
+    const TempFile file("ilona_test_mapped.iwz");
+    Queue queue;
+    enqueue(queue, WasteRecord("1", "Альфа", "адреса", "телефон", "W", "Оливи", PhysicalState::Solid, "01:03:2023", 1, 1.0));
+    CHECK(saveQueueToCompressedFile(queue, file.path()));
+    CHECK_THROWS(std::runtime_error, MappedRecordFile lazy(file.path()));
+    clearQueue(queue);
+}
+
+} // namespace
+
+int main() {
+    testReportsMatchEagerLoad();
+    testRejectsBlockFiles();
+    return testExitCode();
+}
@@ -0,0 +1,128 @@
+#include "merge_load.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+WasteRecord makeRecord(const std::string& companyCode, const std::string& date, const int quantity,
+                       const double cost, const std::string& address = "адреса") {
+    return WasteRecord(companyCode, "Підприємство " + companyCode, address, "телефон", "W-01", "Відхід",
+                       PhysicalState::Solid, date, quantity, cost);
+}
+
+void saveRecords(const std::vector<WasteRecord>& records, const std::string& path, const bool compressed) {
+    Queue queue;
+    for (const WasteRecord& record : records) {
+        enqueue(queue, record);
+    }
+    CHECK(compressed ? saveQueueToCompressedFile(queue, path) : saveQueueToFile(queue, path));
+    clearQueue(queue);
+}
+
+std::vector<std::string> addresses(const Queue& queue) {
+    std::vector<std::string> result;
+    for (const WasteNode* current = queue.head; current != nullptr; current = current->next) {
+        result.push_back(current->data.address);
+    }
+    return result;
+}
+
+void testDeduplicationAndOrder() {
+    const TempFile textFile("ilona_test_merge_a.txt");
+    const TempFile blockFile("ilona_test_merge_b.iwz");
+    saveRecords({ makeRecord("A", "03:01:2023", 1, 10.0, "a1"),
+                  makeRecord("B", "01:01:2023", 2, 20.0, "a2"),
+                  // Дублікат у тому ж файлі: відрізняється лише полями, що не входять у ключ.
+                  makeRecord("B", "01:01:2023", 2, 20.0, "a3"),
+                  makeRecord("C", "02:01:2023", 3, 30.0, "a4") },
+                textFile.path(), false);
+    saveRecords({ makeRecord("D", "02:01:2023", 4, 40.0, "b1"),
+                  // Дублікат запису з першого файлу.
+                  makeRecord("C", "02:01:2023", 3, 30.0, "b2"),
+                  // Вартість відрізняється менше ніж на копійку - той самий запис після округлення.
+                  makeRecord("E", "01:01:2023", 5, 50.001, "b3"),
+                  makeRecord("F", "01:01:2023", 6, 60.0, "b4") },
+                blockFile.path(), true);
+
+    Queue queue;
+    enqueue(queue, makeRecord("E", "01:01:2023", 5, 50.0, "q1"));
+    MergeLoadStats stats;
+    CHECK(mergeQueueFromFiles(queue, { textFile.path(), blockFile.path() }, stats));
+    CHECK(stats.filesRead == 2);
+    CHECK(stats.recordsRead == 8);
+    CHECK(stats.recordsAdded == 5);
+    CHECK(stats.duplicatesSkipped == 3);
+    // Хронологічно; за однакової дати - спершу перший файл, усередині файлу - порядок файлу.
+    CHECK(addresses(queue) == (std::vector<std::string>{ "q1", "a2", "b4", "a4", "b1", "a1" }));
+
+    // Повторне злиття тих самих файлів нічого не додає.
+    CHECK(mergeQueueFromFiles(queue, { blockFile.path(), textFile.path() }, stats));
+    CHECK(stats.recordsAdded == 0);
+    CHECK(stats.duplicatesSkipped == 8);
+    CHECK(queue.size == 6);
+
+    // Файл, який не вдалося прочитати, лишає чергу без змін.
+    CHECK(!mergeQueueFromFiles(queue, { textFile.path(), textFile.path() + ".немає" }, stats));
+    CHECK(queue.size == 6);
+    clearQueue(queue);
+}
+
+// Більше записів, ніж уміщує одна впорядкована частина в пам'яті: злиття йде через
+// кілька тимчасових файлів і має дати той самий порядок, що й стабільне сортування.
+void testManyRuns() {
+    constexpr int RECORD_COUNT = 150000;
+    const TempFile textFile("ilona_test_merge_many.txt");
+    const TempFile blockFile("ilona_test_merge_many.iwz");
+    const char* dates[] = { "05:02:2023", "01:01:2023", "17:12:2022", "01:01:2023", "28:02:2024" };
+    std::vector<WasteRecord> first;
+    std::vector<WasteRecord> second;
+    for (int i = 0; i < RECORD_COUNT; ++i) {
+        (i % 3 == 0 ? second : first).push_back(makeRecord(std::to_string(i), dates[i % 5], 1 + i % 4, 5.0,
+                                                           std::to_string(i)));
+    }
+    // Кожен сьомий запис другого файлу вже є в першому.
+    for (std::size_t i = 0; i < second.size(); i += 7) {
+        second[i] = first[i];
+    }
+    saveRecords(first, textFile.path(), false);
+    saveRecords(second, blockFile.path(), true);
+
+    std::vector<const WasteRecord*> expected;
+    for (const WasteRecord& record : first) {
+        expected.push_back(&record);
+    }
+    for (std::size_t i = 0; i < second.size(); ++i) {
+        if (i % 7 != 0) {
+            expected.push_back(&second[i]);
+        }
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const WasteRecord* left, const WasteRecord* right) {
+        return dateSortKey(left->removalDate) < dateSortKey(right->removalDate);
+    });
+
+    Queue queue;
+    MergeLoadStats stats;
+    CHECK(mergeQueueFromFiles(queue, { textFile.path(), blockFile.path() }, stats));
+    CHECK(stats.recordsRead == first.size() + second.size());
+    CHECK(stats.recordsAdded == expected.size());
+    CHECK(queue.size == expected.size());
+    std::size_t index = 0;
+    bool sameOrder = queue.size == expected.size();
+    for (const WasteNode* current = queue.head; sameOrder && current != nullptr; current = current->next, ++index) {
+        sameOrder = current->data.address == expected[index]->address &&
+            current->data.removalDate == expected[index]->removalDate;
+    }
+    CHECK(sameOrder);
+    clearQueue(queue);
+}
+
+} // namespace
+
+int main() {
+    testDeduplicationAndOrder();
+    testManyRuns();
+    return testExitCode();
+}
@@ -0,0 +1,148 @@
+#include "pickup_priority.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Детермінований генератор, щоб невдалий прогін можна було відтворити.
+class TestRandom {
+public:
+    std::uint32_t next(const std::uint32_t bound) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<std::uint32_t>(state >> 33) % bound;
+    }
+
+private:
+    std::uint64_t state = 42;
+};
+
+WasteRecord randomRecord(TestRandom& random, const int id) {
+    // Мало різних дат і кількостей, щоб часто вирішував порядок додавання.
+    const int day = 1 + static_cast<int>(random.next(5));
+    const int month = 1 + static_cast<int>(random.next(2));
+    std::string date = (day < 10 ? "0" : "") + std::to_string(day) + ":0" + std::to_string(month) + ":2023";
+    if (random.next(50) == 0) {
+        date = "не дата";
+    }
+    return WasteRecord("C" + std::to_string(id), "Підприємство " + std::to_string(id % 7), "адреса", "телефон", "W",
+                       "Відхід", PhysicalState::Solid, date, 1 + static_cast<int>(random.next(3)), 10.0);
+}
+
+// Еталон: повний перебір вузлів черги за тим самим ключем пріоритету.
+class ReferenceOrder {
+public:
+    void added(const WasteNode* node) { sequence[node] = nextSequence++; }
+
+    std::vector<const WasteNode*> sorted(const Queue& queue) const {
+        std::vector<const WasteNode*> nodes;
+        for (const WasteNode* current = queue.head; current != nullptr; current = current->next) {
+            nodes.push_back(current);
+        }
+        std::sort(nodes.begin(), nodes.end(), [this](const WasteNode* left, const WasteNode* right) {
+            return key(left) < key(right);
+        });
+        return nodes;
+    }
+
+private:
+    std::unordered_map<const WasteNode*, std::uint64_t> sequence;
+    std::uint64_t nextSequence = 0;
+
+    std::tuple<std::int32_t, int, std::uint64_t> key(const WasteNode* node) const {
+        return { dateSortKey(node->data.removalDate), -node->data.quantity, sequence.at(node) };
+    }
+};
+
+void checkMatchesReference(PickupPriorityView& view, const Queue& queue, const ReferenceOrder& reference) {
+    CHECK(view.size() == queue.size);
+    const std::vector<const WasteNode*> expected = reference.sorted(queue);
+    if (expected.empty()) {
+        CHECK(view.empty());
+        return;
+    }
+    CHECK(&view.top() == expected.front());
+    const std::size_t count = std::min<std::size_t>(expected.size(), 25);
+    const std::vector<const WasteNode*> upcoming = view.upcoming(count);
+    CHECK(std::equal(upcoming.begin(), upcoming.end(), expected.begin(), expected.begin() + count));
+}
+
+void testRandomOperations() {
+    TestRandom random;
+    ReferenceOrder reference;
+    Queue queue;
+    int nextId = 0;
+
+    // Частина записів існує до створення подання: перевіряє побудову купи знизу вгору.
+    for (; nextId < 300; ++nextId) {
+        enqueue(queue, randomRecord(random, nextId));
+        reference.added(queue.tail);
+    }
+    {
+        PickupPriorityView view(queue);
+        checkMatchesReference(view, queue, reference);
+
+        for (int step = 0; step < 3000; ++step) {
+            const std::uint32_t operation = random.next(10);
+            if (operation < 4 || isEmpty(queue)) {
+                enqueue(queue, randomRecord(random, nextId++));
+                reference.added(queue.tail);
+            } else if (operation < 5) {
+                dequeue(queue);
+            } else if (operation < 6) {
+                view.popNext();
+            } else if (operation < 8) {
+                // Зміна ключа вузла з середини черги.
+                WasteNode* node = queue.head;
+                for (std::uint32_t skip = random.next(static_cast<std::uint32_t>(queue.size)); skip > 0; --skip) {
+                    node = node->next;
+                }
+                WasteRecord changed = node->data;
+                const WasteRecord source = randomRecord(random, 0);
+                changed.removalDate = source.removalDate;
+                changed.quantity = source.quantity;
+                replaceRecord(queue, *node, std::move(changed));
+            } else if (operation < 9) {
+                WasteNode* node = queue.tail;
+                for (std::uint32_t skip = random.next(static_cast<std::uint32_t>(queue.size)); skip > 0; --skip) {
+                    node = node->prev;
+                }
+                removeNode(queue, node);
+            } else {
+                // Перестановка вузлів черги не змінює пріоритетів.
+                sortQueueByQuantityThenCost(queue, SortingDirection::DESC);
+            }
+            if (step % 50 == 0) {
+                checkMatchesReference(view, queue, reference);
+            }
+        }
+        checkMatchesReference(view, queue, reference);
+
+        // Вилучення за пріоритетом до кінця дає повний відсортований порядок.
+        const std::vector<const WasteNode*> expected = reference.sorted(queue);
+        std::vector<std::string> expectedCodes;
+        for (const WasteNode* node : expected) {
+            expectedCodes.push_back(node->data.companyCode);
+        }
+        std::vector<std::string> poppedCodes;
+        while (!view.empty()) {
+            poppedCodes.push_back(view.popNext().companyCode);
+        }
+        CHECK(poppedCodes == expectedCodes);
+        CHECK(isEmpty(queue));
+        CHECK_THROWS(std::out_of_range, view.top());
+    }
+    clearQueue(queue);
+}
+
+} // namespace
+
+int main() {
+    testRandomOperations();
+    return testExitCode();
+}
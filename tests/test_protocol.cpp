@@ -0,0 +1,185 @@
+#include "protocol.h"
+#include "test_support.h"
+
+#include <string>
+
+namespace {
+
+WasteRecord sampleRecord(const std::string& companyName = "ТОВ Екосервіс") {
+    return WasteRecord("12345678", companyName, "вул. Промислова, 1", "+380441234567", "W-01", "Відпрацьовані оливи",
+                       PhysicalState::Liquid, "15:03:2022", 4, 1250.50);
+}
+
+std::string rawFrame(const std::string& payload) {
+    std::string out;
+    const std::size_t frameStart = beginFrame(out);
+    out += payload;
+    finishFrame(out, frameStart);
+    return out;
+}
+
+std::string requestFrame(const RequestType type, const WasteRecord* record = nullptr) {
+    std::string out;
+    const std::size_t frameStart = beginFrame(out);
+    ProtocolWriter writer(out);
+    writer.putU8(static_cast<std::uint8_t>(type));
+    if (record != nullptr) {
+        writer.putRecord(*record);
+    }
+    finishFrame(out, frameStart);
+    return out;
+}
+
+std::string updateFrame(const std::string& companyName, const std::uint32_t matchIndex, const WasteRecord& record) {
+    std::string out;
+    const std::size_t frameStart = beginFrame(out);
+    ProtocolWriter writer(out);
+    writer.putU8(static_cast<std::uint8_t>(RequestType::Update));
+    writer.putString(companyName);
+    writer.putU32(matchIndex);
+    writer.putRecord(record);
+    finishFrame(out, frameStart);
+    return out;
+}
+
+// Виконує всі кадри запитів і повертає статус кожної відповіді.
+std::vector<ResponseStatus> execute(ProtocolContext& context, const std::string& requests, std::string& responses) {
+    std::size_t offset = 0;
+    const char* payload = nullptr;
+    std::size_t payloadSize = 0;
+    while (nextFrame(requests, offset, payload, payloadSize)) {
+        handleProtocolRequest(context, payload, payloadSize, responses);
+    }
+    std::vector<ResponseStatus> statuses;
+    offset = 0;
+    while (nextFrame(responses, offset, payload, payloadSize)) {
+        statuses.push_back(static_cast<ResponseStatus>(payload[0]));
+    }
+    return statuses;
+}
+
+void testFrameParsing() {
+    const WasteRecord record = sampleRecord();
+    const std::string frames = requestFrame(RequestType::Ping) + requestFrame(RequestType::Enqueue, &record);
+
+    std::size_t offset = 0;
+    const char* payload = nullptr;
+    std::size_t payloadSize = 0;
+    CHECK(nextFrame(frames, offset, payload, payloadSize));
+    CHECK(payloadSize == 1 && payload[0] == static_cast<char>(RequestType::Ping));
+    CHECK(offset == FRAME_HEADER_SIZE + 1);
+    CHECK(nextFrame(frames, offset, payload, payloadSize));
+    CHECK(offset == frames.size());
+    ProtocolReader reader(payload + 1, payloadSize - 1);
+    const WasteRecord decoded = reader.getRecord();
+    CHECK(reader.atEnd());
+    CHECK(decoded.companyName == record.companyName && decoded.removalDate == record.removalDate &&
+          decoded.state == record.state && decoded.quantity == record.quantity && decoded.cost == record.cost);
+    CHECK(!nextFrame(frames, offset, payload, payloadSize));
+
+    // Неповний заголовок і неповне навантаження чекають на решту байтів.
+    for (std::size_t cut = 0; cut < frames.size() - FRAME_HEADER_SIZE - 1; ++cut) {
+        const std::string partial = frames.substr(FRAME_HEADER_SIZE + 1, cut);
+        offset = 0;
+        CHECK(!nextFrame(partial, offset, payload, payloadSize));
+        CHECK(offset == 0);
+    }
+
+    std::string oversized;
+    const std::size_t frameStart = beginFrame(oversized);
+    finishFrame(oversized, frameStart);
+    const std::uint32_t length = MAX_FRAME_SIZE + 1;
+    for (std::size_t i = 0; i < FRAME_HEADER_SIZE; ++i) {
+        oversized[i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+    }
+    offset = 0;
+    CHECK_THROWS(ProtocolError, nextFrame(oversized, offset, payload, payloadSize));
+
+    const char truncated[] = { static_cast<char>(RequestType::Enqueue), 5, 0, 0, 0, 'a' };
+    ProtocolReader truncatedReader(truncated + 1, sizeof(truncated) - 1);
+    CHECK_THROWS(ProtocolError, truncatedReader.getRecord());
+}
+
+void testRequests() {
+    Queue queue;
+    {
+        ReportCache reportCache(queue);
+        PickupPriorityView pickupView(queue);
+        ProtocolContext context{ queue, reportCache, pickupView };
+
+        const WasteRecord record = sampleRecord();
+        WasteRecord badCost = sampleRecord();
+        badCost.cost = 0.0;
+        std::string requests = requestFrame(RequestType::Enqueue, &record) + requestFrame(RequestType::Size) +
+            requestFrame(RequestType::Enqueue, &badCost) + requestFrame(RequestType::Dequeue) +
+            requestFrame(RequestType::Dequeue) + rawFrame("\x7F");
+        std::string responses;
+        const std::vector<ResponseStatus> statuses = execute(context, requests, responses);
+        CHECK(statuses.size() == 6);
+        if (statuses.size() == 6) {
+            CHECK(statuses[0] == ResponseStatus::Ok);
+            CHECK(statuses[1] == ResponseStatus::Ok);
+            CHECK(statuses[2] == ResponseStatus::BadRequest);
+            CHECK(statuses[3] == ResponseStatus::Ok);
+            CHECK(statuses[4] == ResponseStatus::NotFound);
+            CHECK(statuses[5] == ResponseStatus::BadRequest);
+        }
+        CHECK(isEmpty(queue));
+
+        // Зайві байти після запиту і порожній кадр без коду операції.
+        const std::string malformed = rawFrame(std::string(1, static_cast<char>(RequestType::Size)) + '\0') + rawFrame("");
+        responses.clear();
+        CHECK(execute(context, malformed, responses) ==
+              (std::vector<ResponseStatus>{ ResponseStatus::BadRequest, ResponseStatus::BadRequest }));
+    }
+    clearQueue(queue);
+}
+
+// Текстове поле, що збігається з роздільником записів або містить переведення рядка,
+// розірвало б запис при збереженні черги, тож сервер такі запити відхиляє.
+void testSeparatorInjection() {
+    CHECK(isValidTextField("---END_RECORD--- "));
+    CHECK(!isValidTextField("---END_RECORD---"));
+    CHECK(!isValidTextField("рядок\nще рядок"));
+    CHECK(!isValidTextField("рядок\r"));
+
+    Queue queue;
+    {
+        ReportCache reportCache(queue);
+        PickupPriorityView pickupView(queue);
+        ProtocolContext context{ queue, reportCache, pickupView };
+
+        const WasteRecord valid = sampleRecord();
+        WasteRecord separatorName = sampleRecord("---END_RECORD---");
+        WasteRecord separatorAddress = sampleRecord();
+        separatorAddress.address = "---END_RECORD---";
+        WasteRecord newlinePhone = sampleRecord();
+        newlinePhone.phone = "0\n---END_RECORD---";
+
+        const std::string requests = requestFrame(RequestType::Enqueue, &valid) +
+            requestFrame(RequestType::Enqueue, &separatorName) + requestFrame(RequestType::Enqueue, &separatorAddress) +
+            requestFrame(RequestType::Enqueue, &newlinePhone) + updateFrame(valid.companyName, 0, separatorName) +
+            updateFrame(valid.companyName, 0, newlinePhone);
+        std::string responses;
+        const std::vector<ResponseStatus> statuses = execute(context, requests, responses);
+        CHECK(statuses.size() == 6);
+        CHECK(!statuses.empty() && statuses[0] == ResponseStatus::Ok);
+        for (std::size_t i = 1; i < statuses.size(); ++i) {
+            CHECK(statuses[i] == ResponseStatus::BadRequest);
+        }
+        CHECK(queue.size == 1);
+        CHECK(queue.head != nullptr && queue.head->data.companyName == valid.companyName);
+        CHECK(recordValidationError(separatorAddress) != nullptr);
+        CHECK(recordValidationError(valid) == nullptr);
+    }
+    clearQueue(queue);
+}
+
+} // namespace
+
+int main() {
+    testFrameParsing();
+    testRequests();
+    testSeparatorInjection();
+    return testExitCode();
+}
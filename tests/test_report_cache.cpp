@@ -0,0 +1,107 @@
+#include "bulk_ops.h"
+#include "report_cache.h"
+#include "test_support.h"
+
+#include <string>
+
+namespace {
+
+WasteRecord makeRecord(const std::string& companyName, const std::string& wasteName, const PhysicalState state,
+                       const std::string& date, const int quantity, const double cost) {
+    return WasteRecord("12345678", companyName, "адреса", "телефон", "W-01", wasteName, state, date, quantity, cost);
+}
+
+// Порівнює кожен звіт кешу з тим самим звітом, обчисленим наново по черзі.
+void checkCacheMatchesQueue(ReportCache& cache, const Queue& queue) {
+    const char* companies[] = { "Альфа", "Бета", "Гама" };
+    const char* wastes[] = { "Оливи", "Шини" };
+    const char* dates[] = { "01:03:2023", "02:03:2023" };
+    for (const char* company : companies) {
+        for (const char* waste : wastes) {
+            const CostReport cached = cache.costByCompanyAndWaste(company, waste);
+            const CostReport fresh = costByCompanyAndWaste(queue, company, waste);
+            // Порівняння точне: кеш має повторювати порядок підсумовування звіту.
+            CHECK(cached.totalCost == fresh.totalCost);
+            CHECK(cached.matchedRecords == fresh.matchedRecords);
+        }
+        const QuantityReport cached = cache.quantityByCompanyAndDateRange(company, "01:03:2023", "01:03:2023");
+        const QuantityReport fresh = quantityByCompanyAndDateRange(queue, company, "01:03:2023", "01:03:2023");
+        CHECK(cached.totalQuantity == fresh.totalQuantity && cached.matchedRecords == fresh.matchedRecords);
+        const QuantityReport cachedWide = cache.quantityByCompanyAndDateRange(company, "01:01:2023", "31:12:2023");
+        const QuantityReport freshWide = quantityByCompanyAndDateRange(queue, company, "01:01:2023", "31:12:2023");
+        CHECK(cachedWide.totalQuantity == freshWide.totalQuantity && cachedWide.matchedRecords == freshWide.matchedRecords);
+    }
+    for (const char* waste : wastes) {
+        for (const char* date : dates) {
+            CHECK(cache.companiesByWasteAndDate(waste, date) == companiesByWasteAndDate(queue, waste, date));
+        }
+    }
+    for (const PhysicalState state : { PhysicalState::Solid, PhysicalState::Liquid, PhysicalState::Gas }) {
+        CHECK(cache.companiesByPhysicalState(state) == companiesByPhysicalState(queue, state));
+    }
+}
+
+void testInvalidation() {
+    Queue queue;
+    {
+        ReportCache cache(queue);
+        // Вартості різних порядків величини: сума залежить від порядку доданків.
+        const double costs[] = { 1e9, 0.01, 0.07, 3.33, 123456.78, 0.03, 9.99 };
+        for (int i = 0; i < 70; ++i) {
+            enqueue(queue, makeRecord(i % 3 == 0 ? "Альфа" : "Бета", i % 2 == 0 ? "Оливи" : "Шини",
+                                      i % 5 == 0 ? PhysicalState::Liquid : PhysicalState::Solid,
+                                      i % 4 == 0 ? "01:03:2023" : "02:03:2023", 1 + i % 6, costs[i % 7] + i * 0.01));
+        }
+        checkCacheMatchesQueue(cache, queue);
+        const std::size_t entries = cache.cachedEntries();
+        CHECK(entries > 0);
+
+        // Поля, яких звіти не читають, нічого не скидають.
+        WasteRecord changed = queue.head->next->data;
+        changed.phone = "+380000000000";
+        changed.address = "нова адреса";
+        replaceRecord(queue, *queue.head->next, std::move(changed));
+        CHECK(cache.cachedEntries() == entries);
+        checkCacheMatchesQueue(cache, queue);
+
+        enqueue(queue, makeRecord("Гама", "Оливи", PhysicalState::Gas, "01:03:2023", 3, 7.5));
+        checkCacheMatchesQueue(cache, queue);
+
+        changed = queue.head->data;
+        changed.companyName = "Гама";
+        changed.state = PhysicalState::Gas;
+        changed.removalDate = "02:03:2023";
+        replaceRecord(queue, *queue.head, std::move(changed));
+        checkCacheMatchesQueue(cache, queue);
+
+        removeNode(queue, queue.head->next->next);
+        dequeue(queue);
+        checkCacheMatchesQueue(cache, queue);
+
+        CHECK(updateWhere(queue, [](const WasteRecord& record) { return record.quantity == 2; }, RecordField::Cost,
+                          "0.5") > 0);
+        checkCacheMatchesQueue(cache, queue);
+        CHECK(deleteWhere(queue, [](const WasteRecord& record) { return record.wasteName == "Шини"; }) > 0);
+        checkCacheMatchesQueue(cache, queue);
+
+        // Після сортування суми вартостей рахуються в новому порядку вузлів.
+        sortQueueByQuantityThenCost(queue, SortingDirection::ASC);
+        checkCacheMatchesQueue(cache, queue);
+        sortQueueByQuantityThenCost(queue, SortingDirection::DESC);
+        checkCacheMatchesQueue(cache, queue);
+
+        CHECK_THROWS(std::invalid_argument, cache.quantityByCompanyAndDateRange("Альфа", "02:03:2023", "01:03:2023"));
+
+        clearQueue(queue);
+        CHECK(cache.cachedEntries() == 0);
+        checkCacheMatchesQueue(cache, queue);
+    }
+    clearQueue(queue);
+}
+
+} // namespace
+
+int main() {
+    testInvalidation();
+    return testExitCode();
+}
@@ -0,0 +1,75 @@
+#ifndef ILONA_TEST_SUPPORT_H
+#define ILONA_TEST_SUPPORT_H
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Мінімальні перевірки для тестів ctest. CHECK не зупиняє тест, а лише повідомляє
+// про невдачу; main кожного тесту повертає testExitCode().
+
+inline int& failedChecks() {
+    static int count = 0;
+    return count;
+}
+
+#define CHECK(condition)                                                                          \
+    do {                                                                                          \
+        if (!(condition)) {                                                                       \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": перевірка не пройшла: " #condition "\n"; \
+            ++failedChecks();                                                                     \
+        }                                                                                         \
+    } while (false)
+
+template <typename Exception, typename Fn>
+bool throwsException(Fn&& fn) {
+    try {
+        fn();
+    } catch (const Exception&) {
+        return true;
+    } catch (...) {
+        return false;
+    }
+    return false;
+}
+
+#define CHECK_THROWS(ExceptionType, expression) CHECK(throwsException<ExceptionType>([&] { expression; }))
+
+inline int testExitCode() {
+    return failedChecks() == 0 ? 0 : 1;
+}
+
+// Шлях у тимчасовому каталозі; файл видаляється в деструкторі.
+class TempFile {
+public:
+    explicit TempFile(const std::string& name)
+        : filePath((std::filesystem::temp_directory_path() / name).string()) {}
+    ~TempFile() {
+        std::error_code error;
+        std::filesystem::remove(filePath, error);
+    }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::string& path() const { return filePath; }
+
+    std::string read() const {
+        std::ifstream in(filePath, std::ios::binary);
+        std::ostringstream content;
+        content << in.rdbuf();
+        return content.str();
+    }
+
+    void write(const std::string& content) const {
+        std::ofstream out(filePath, std::ios::binary | std::ios::trunc);
+        out << content;
+    }
+
+private:
+    std::string filePath;
+};
+
+#endif
@@ -0,0 +1,291 @@
+#include "trend_report.h"
+
+#include "metrics.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+
+// Група посилається на рядки вузлів черги: під час проходу черга не змінюється,
+// тож рядки копіюються у звіт лише один раз на групу, а не на кожен запис.
+struct TrendGroup {
+    std::string_view companyName;
+    std::string_view wasteName;
+    PhysicalState state;
+
+    bool operator==(const TrendGroup& other) const {
+        return state == other.state && companyName == other.companyName && wasteName == other.wasteName;
+    }
+};
+
+struct TrendGroupHash {
+    std::size_t operator()(const TrendGroup& group) const {
+        const std::hash<std::string_view> hashString;
+        const std::size_t hash = hashString(group.companyName) * 31 + hashString(group.wasteName);
+        return hash * 31 + static_cast<std::size_t>(group.state);
+    }
+};
+
+// Запис, зведений до чисел: групу вже визначено, дату розкладено на місяць і тиждень.
+struct TrendSample {
+    std::uint32_t groupId;
+    std::int32_t monthKey;
+    std::int32_t weekKey;
+    std::int32_t quantity;
+    double cost;
+};
+
+struct PartialTrends {
+    std::unordered_map<TrendGroup, std::uint32_t, TrendGroupHash> groupIds;
+    std::vector<TrendGroup> groups;
+    std::vector<TrendSample> samples;
+    std::size_t skippedRecords = 0;
+
+    std::uint32_t groupId(const TrendGroup& group) {
+        const auto inserted = groupIds.emplace(group, static_cast<std::uint32_t>(groups.size()));
+        if (inserted.second) {
+            groups.push_back(group);
+        }
+        return inserted.first->second;
+    }
+};
+
+// Ключ суми - ранг групи у старших 32 бітах і період у молодших, тож порядок ключів
+// збігається з порядком рядків звіту.
+struct TrendAggregate {
+    std::uint64_t key;
+    long long quantity;
+    double cost;
+    std::size_t records;
+};
+
+std::uint64_t aggregateKey(const std::uint32_t groupRank, const std::int32_t periodKey) {
+    return (static_cast<std::uint64_t>(groupRank) << 32) | static_cast<std::uint32_t>(periodKey);
+}
+
+// Сортує суми за ключем і зливає сусідні з однаковим ключем.
+void sortAndReduce(std::vector<TrendAggregate>& aggregates) {
+    std::sort(aggregates.begin(), aggregates.end(), [](const TrendAggregate& left, const TrendAggregate& right) {
+        return left.key < right.key;
+    });
+    std::size_t reduced = 0;
+    for (const TrendAggregate& aggregate : aggregates) {
+        if (reduced > 0 && aggregates[reduced - 1].key == aggregate.key) {
+            TrendAggregate& target = aggregates[reduced - 1];
+            target.quantity += aggregate.quantity;
+            target.cost += aggregate.cost;
+            target.records += aggregate.records;
+        } else {
+            aggregates[reduced++] = aggregate;
+        }
+    }
+    aggregates.resize(reduced);
+}
+
+// Кількість днів від 01.01.1970 за пролептичним григоріанським календарем.
+std::int64_t daysFromCivil(std::int32_t year, const std::int32_t month, const std::int32_t day) {
+    year -= month <= 2 ? 1 : 0;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const std::int64_t yearOfEra = year - era * 400;
+    const std::int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const std::int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// Тиждень ISO 8601 (РРРРТТ): тиждень з понеділка, належить року, на який припадає його четвер.
+std::int32_t isoWeekKey(const std::int32_t year, const std::int32_t month, const std::int32_t day) {
+    const std::int64_t days = daysFromCivil(year, month, day);
+    const std::int64_t weekdayFromMonday = ((days + 3) % 7 + 7) % 7;  // 01.01.1970 - четвер
+    const std::int64_t thursday = days - weekdayFromMonday + 3;
+
+    std::int32_t isoYear = year;
+    if (thursday < daysFromCivil(year, 1, 1)) {
+        isoYear = year - 1;
+    } else if (thursday >= daysFromCivil(year + 1, 1, 1)) {
+        isoYear = year + 1;
+    }
+    const std::int64_t week = (thursday - daysFromCivil(isoYear, 1, 1)) / 7 + 1;
+    return isoYear * 100 + static_cast<std::int32_t>(week);
+}
+
+std::vector<TrendRow> toRows(const std::vector<TrendAggregate>& aggregates, const std::vector<TrendGroup>& groupsByRank) {
+    std::vector<TrendRow> rows;
+    rows.reserve(aggregates.size());
+    for (const TrendAggregate& aggregate : aggregates) {
+        const TrendGroup& group = groupsByRank[aggregate.key >> 32];
+        TrendRow row{ std::string(group.companyName), std::string(group.wasteName), group.state,
+                      static_cast<std::int32_t>(aggregate.key & 0xFFFFFFFFu) };
+        row.totalQuantity = aggregate.quantity;
+        row.totalCost = aggregate.cost;
+        row.matchedRecords = aggregate.records;
+        rows.push_back(std::move(row));
+    }
+    return rows;
+}
+
+std::string csvField(const std::string& value) {
+    if (value.find_first_of(",\"\r\n") == std::string::npos) {
+        return value;
+    }
+    std::string quoted = "\"";
+    for (const char c : value) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    return quoted + '"';
+}
+
+void writeCsvRows(std::ostream& out, const TrendPeriod period, const std::vector<TrendRow>& rows) {
+    const char* periodType = period == TrendPeriod::Month ? "month" : "week";
+    for (const TrendRow& row : rows) {
+        out << periodType << ','
+            << getTrendPeriodLabel(period, row.periodKey) << ','
+            << csvField(row.companyName) << ','
+            << csvField(row.wasteName) << ','
+            << csvField(getPhysicalStateString(row.state)) << ','
+            << row.matchedRecords << ','
+            << row.totalQuantity << ','
+            << row.totalCost << '\n';
+    }
+}
+
+} // namespace
+
+std::string getTrendPeriodLabel(const TrendPeriod period, const std::int32_t periodKey) {
+    const std::int32_t number = periodKey % 100;
+    std::string label = std::to_string(periodKey / 100) + (period == TrendPeriod::Month ? "-" : "-W");
+    if (number < 10) {
+        label += '0';
+    }
+    return label + std::to_string(number);
+}
+
+TrendReport buildTrendReport(const Queue& queue) {
+    ILONA_TIME_OPERATION(MetricOperation::ReportTrends);
+    std::vector<const WasteNode*> nodes;
+    nodes.reserve(queue.size);
+    for (const WasteNode* current = queue.head; current != nullptr; current = current->next) {
+        nodes.push_back(current);
+    }
+
+    // Один шматок на потік: кожен потік розбирає свої записи без синхронізації.
+    const std::size_t threadCount = std::max<std::size_t>(1, std::min(workerThreadCount(), nodes.size()));
+    const std::size_t chunkSize = (nodes.size() + threadCount - 1) / threadCount;
+    std::vector<PartialTrends> partials(threadCount);
+    parallelFor(nodes.size(), chunkSize, [&](const std::size_t begin, const std::size_t end) {
+        PartialTrends& partial = partials[begin / chunkSize];
+        partial.samples.reserve(end - begin);
+        for (std::size_t i = begin; i < end; ++i) {
+            const WasteRecord& record = nodes[i]->data;
+            const std::int32_t dateKey = dateSortKey(record.removalDate);
+            const std::int32_t year = dateKey / 10000;
+            const std::int32_t month = dateKey / 100 % 100;
+            const std::int32_t day = dateKey % 100;
+            if (dateKey == std::numeric_limits<std::int32_t>::max() || month < 1 || month > 12 || day < 1 || day > 31) {
+                ++partial.skippedRecords;
+                continue;
+            }
+            const std::uint32_t groupId = partial.groupId(TrendGroup{ record.companyName, record.wasteName, record.state });
+            partial.samples.push_back(TrendSample{ groupId, year * 100 + month, isoWeekKey(year, month, day),
+                                                   record.quantity, record.cost });
+        }
+    });
+
+    // Спільна нумерація груп в алфавітному порядку, щоб ключі сум одразу давали порядок звіту.
+    std::unordered_map<TrendGroup, std::uint32_t, TrendGroupHash> globalIds;
+    std::vector<TrendGroup> groups;
+    std::vector<std::vector<std::uint32_t>> localToGlobal(partials.size());
+    for (std::size_t p = 0; p < partials.size(); ++p) {
+        localToGlobal[p].reserve(partials[p].groups.size());
+        for (const TrendGroup& group : partials[p].groups) {
+            const auto inserted = globalIds.emplace(group, static_cast<std::uint32_t>(groups.size()));
+            if (inserted.second) {
+                groups.push_back(group);
+            }
+            localToGlobal[p].push_back(inserted.first->second);
+        }
+    }
+    std::vector<std::uint32_t> byName(groups.size());
+    for (std::uint32_t i = 0; i < byName.size(); ++i) {
+        byName[i] = i;
+    }
+    std::sort(byName.begin(), byName.end(), [&groups](const std::uint32_t left, const std::uint32_t right) {
+        const TrendGroup& a = groups[left];
+        const TrendGroup& b = groups[right];
+        return std::tie(a.companyName, a.wasteName, a.state) < std::tie(b.companyName, b.wasteName, b.state);
+    });
+    std::vector<std::uint32_t> rank(groups.size());
+    std::vector<TrendGroup> groupsByRank(groups.size(), TrendGroup{ {}, {}, PhysicalState::Solid });
+    for (std::uint32_t i = 0; i < byName.size(); ++i) {
+        rank[byName[i]] = i;
+        groupsByRank[i] = groups[byName[i]];
+    }
+
+    // Часткові суми кожного потоку: вибірки згортаються сортуванням за цілим ключем.
+    std::vector<std::vector<TrendAggregate>> partialMonthly(partials.size());
+    std::vector<std::vector<TrendAggregate>> partialWeekly(partials.size());
+    parallelFor(partials.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t p = begin; p < end; ++p) {
+            std::vector<TrendAggregate>& monthly = partialMonthly[p];
+            std::vector<TrendAggregate>& weekly = partialWeekly[p];
+            monthly.reserve(partials[p].samples.size());
+            weekly.reserve(partials[p].samples.size());
+            for (const TrendSample& sample : partials[p].samples) {
+                const std::uint32_t groupRank = rank[localToGlobal[p][sample.groupId]];
+                monthly.push_back(TrendAggregate{ aggregateKey(groupRank, sample.monthKey), sample.quantity, sample.cost, 1 });
+                weekly.push_back(TrendAggregate{ aggregateKey(groupRank, sample.weekKey), sample.quantity, sample.cost, 1 });
+            }
+            std::vector<TrendSample>().swap(partials[p].samples);
+            sortAndReduce(monthly);
+            sortAndReduce(weekly);
+        }
+    });
+
+    auto mergePartials = [](std::vector<std::vector<TrendAggregate>>& parts) {
+        std::vector<TrendAggregate> merged = std::move(parts.front());
+        for (std::size_t p = 1; p < parts.size(); ++p) {
+            merged.insert(merged.end(), parts[p].begin(), parts[p].end());
+            std::vector<TrendAggregate>().swap(parts[p]);
+        }
+        if (parts.size() > 1) {
+            sortAndReduce(merged);
+        }
+        return merged;
+    };
+
+    TrendReport report;
+    report.monthly = toRows(mergePartials(partialMonthly), groupsByRank);
+    report.weekly = toRows(mergePartials(partialWeekly), groupsByRank);
+    for (const PartialTrends& partial : partials) {
+        report.skippedRecords += partial.skippedRecords;
+    }
+    return report;
+}
+
+bool writeTrendReportCsv(const TrendReport& report, const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Помилка: не вдалося відкрити файл для запису: " << filename << std::endl;
+        return false;
+    }
+    out << std::fixed << std::setprecision(2);
+    out << "period_type,period,company,waste,state,records,quantity,cost\n";
+    writeCsvRows(out, TrendPeriod::Month, report.monthly);
+    writeCsvRows(out, TrendPeriod::Week, report.weekly);
+    out.close();
+    if (!out) {
+        std::cerr << "Помилка: не вдалося записати файл: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,46 @@
+#ifndef ILONA_TREND_REPORT_H
+#define ILONA_TREND_REPORT_H
+
+#include "waste_queue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Динаміка кількості та вартості вивезень за місяцями і тижнями ISO 8601
+// в розрізі підприємства, виду відходу та агрегатного стану.
+// Усі періоди для всіх груп рахуються за один прохід черги: кожен потік
+// накопичує власні часткові суми, які об'єднуються наприкінці.
+
+enum class TrendPeriod {
+    Month = 1,
+    Week = 2
+};
+
+struct TrendRow {
+    std::string companyName;
+    std::string wasteName;
+    PhysicalState state;
+    std::int32_t periodKey;  // РРРРММ для місяців, РРРРТТ (рік і тиждень за ISO) для тижнів
+    long long totalQuantity = 0;
+    double totalCost = 0.0;
+    std::size_t matchedRecords = 0;
+};
+
+// Рядки впорядковано за підприємством, видом відходу, станом і періодом.
+struct TrendReport {
+    std::vector<TrendRow> monthly;
+    std::vector<TrendRow> weekly;
+    std::size_t skippedRecords = 0;  // записи з некоректною датою
+};
+
+// "2023-07" для місяця, "2023-W05" для тижня.
+std::string getTrendPeriodLabel(TrendPeriod period, std::int32_t periodKey);
+
+TrendReport buildTrendReport(const Queue& queue);
+
+// CSV (UTF-8, роздільник - кома) з обома розрізами; колонка period_type - month або week.
+bool writeTrendReportCsv(const TrendReport& report, const std::string& filename);
+
+#endif
@@ -0,0 +1,537 @@
+#include "waste_queue.h"
+
+#include "compression.h"
+#include "metrics.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+const std::string RECORD_SEPARATOR = "---END_RECORD---";
+
+[[maybe_unused]] std::uintmax_t fileSizeOnDisk(const std::string& filename) {
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(filename, error);
+    return error ? 0 : size;
+}
+
+} // namespace
+
+bool isValidPhysicalState(const int stateInt) {
+    return stateInt == static_cast<int>(PhysicalState::Solid) ||
+        stateInt == static_cast<int>(PhysicalState::Liquid) ||
+        stateInt == static_cast<int>(PhysicalState::Gas);
+}
+
+std::string getPhysicalStateString(const PhysicalState state) {
+    switch (state) {
+    case PhysicalState::Solid: return "Твердий";
+    case PhysicalState::Liquid: return "Рідкий";
+    case PhysicalState::Gas: return "Газоподібний";
+    default: throw std::invalid_argument("Такого фізичного стану не існує.");
+    }
+}
+
+bool isEmpty(const Queue& queue) {
+    return queue.head == nullptr;
+}
+
+void clearQueue(Queue& queue) {
+    for (QueueListener* listener : queue.listeners) {
+        listener->onQueueCleared();
+    }
+    while (queue.head) {
+        const WasteNode* temp = queue.head;
+        queue.head = queue.head->next;
+        delete temp;
+    }
+    queue.tail = nullptr;
+    queue.size = 0;
+}
+
+WasteRecord peek(const Queue& queue) {
+    if (isEmpty(queue)) {
+        throw std::out_of_range("Черга порожня");
+    }
+    return queue.head->data;
+}
+
+void enqueue(Queue& queue, WasteRecord&& record) {
+    ILONA_TIME_OPERATION(MetricOperation::Enqueue);
+    WasteNode* newNode = new WasteNode(std::move(record));
+
+    if (isEmpty(queue)) {
+        queue.head = queue.tail = newNode;
+    }
+    else {
+        if (queue.tail != nullptr) {
+            newNode->prev = queue.tail;
+            queue.tail->next = newNode;
+            queue.tail = newNode;
+        }
+        else {
+            newNode->prev = queue.head;
+            queue.head->next = newNode;
+            queue.tail = newNode;
+        }
+    }
+    ++queue.size;
+    for (QueueListener* listener : queue.listeners) {
+        listener->onRecordAdded(*newNode);
+    }
+}
+
+void enqueue(Queue& queue, const WasteRecord& record) {
+    enqueue(queue, WasteRecord(record));
+}
+
+WasteRecord dequeue(Queue& queue) {
+    ILONA_TIME_OPERATION(MetricOperation::Dequeue);
+    if (isEmpty(queue)) {
+        throw std::out_of_range("Черга порожня");
+    }
+
+    for (QueueListener* listener : queue.listeners) {
+        listener->onRecordRemoved(*queue.head);
+    }
+
+    const WasteNode* tempNode = queue.head;
+    WasteRecord removedData = tempNode->data;
+    queue.head = tempNode->next;
+
+    if (isEmpty(queue)) {
+        queue.tail = nullptr;
+    } else {
+        queue.head->prev = nullptr;
+    }
+
+    delete tempNode;
+    --queue.size;
+    return removedData;
+}
+
+WasteRecord removeNode(Queue& queue, WasteNode* node) {
+    ILONA_TIME_OPERATION(MetricOperation::Dequeue);
+    for (QueueListener* listener : queue.listeners) {
+        listener->onRecordRemoved(*node);
+    }
+
+    if (node->prev != nullptr) {
+        node->prev->next = node->next;
+    } else {
+        queue.head = node->next;
+    }
+    if (node->next != nullptr) {
+        node->next->prev = node->prev;
+    } else {
+        queue.tail = node->prev;
+    }
+
+    WasteRecord removedData = std::move(node->data);
+    delete node;
+    --queue.size;
+    return removedData;
+}
+
+void replaceRecord(Queue& queue, WasteNode& node, WasteRecord&& record) {
+    WasteRecord previous = std::move(node.data);
+    node.data = std::move(record);
+    for (QueueListener* listener : queue.listeners) {
+        listener->onRecordUpdated(node, previous);
+    }
+}
+
+void addQueueListener(Queue& queue, QueueListener* listener) {
+    if (std::find(queue.listeners.begin(), queue.listeners.end(), listener) == queue.listeners.end()) {
+        queue.listeners.push_back(listener);
+    }
+}
+
+void removeQueueListener(Queue& queue, QueueListener* listener) {
+    queue.listeners.erase(std::remove(queue.listeners.begin(), queue.listeners.end(), listener),
+                          queue.listeners.end());
+}
+
+bool isValidTextField(const std::string& value) {
+    return value.find_first_of("\r\n") == std::string::npos && value != RECORD_SEPARATOR;
+}
+
+const char* recordValidationError(const WasteRecord& record) {
+    if (!isValidTextField(record.companyCode) || !isValidTextField(record.companyName) ||
+        !isValidTextField(record.address) || !isValidTextField(record.phone) ||
+        !isValidTextField(record.wasteCode) || !isValidTextField(record.wasteName)) {
+        return "Текстові поля не можуть містити переведення рядка або збігатися з роздільником записів";
+    }
+    if (!isValidDate(record.removalDate)) {
+        return "Некоректна дата вивезення";
+    }
+    if (record.quantity < MIN_QUANTITY) {
+        return "Кількість має бути не менше 1";
+    }
+    if (!(record.cost >= MIN_COST)) {
+        return "Вартість має бути не менше 0.01";
+    }
+    return nullptr;
+}
+
+bool isLeapYear(const int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+bool isValidDate(const std::string_view date) {
+    // Формат ДД:ММ:РРРР перевіряє dateSortKey - без регулярного виразу, бо це гарячий шлях завантаження.
+    const std::int32_t key = dateSortKey(date);
+    if (key == std::numeric_limits<std::int32_t>::max()) {
+        return false;
+    }
+
+    const int day = key % 100;
+    const int month = key / 100 % 100;
+    const int year = key / 10000;
+
+    if (month < 1 || month > 12) return false;
+    if (year < 1900 || year > 2025) return false;
+
+    int daysInMonth[] = { 31,28,31,30,31,30,31,31,30,31,30,31 };
+    if (isLeapYear(year)) {
+        daysInMonth[1] = 29;
+    }
+
+    return day >= 1 && day <= daysInMonth[month - 1];
+}
+
+std::string convertDateToComparableFormat(const std::string& date_ddmmyyyy) {
+    if (date_ddmmyyyy.length() != 10 || date_ddmmyyyy[2] != ':' || date_ddmmyyyy[5] != ':') {
+        throw std::invalid_argument("Неправильний формат дати для конвертації: " + date_ddmmyyyy);
+    }
+    return date_ddmmyyyy.substr(6, 4) + date_ddmmyyyy.substr(3, 2) + date_ddmmyyyy.substr(0, 2);
+}
+
+std::int32_t dateSortKey(const std::string_view date) {
+    if (date.length() != 10 || date[2] != ':' || date[5] != ':') {
+        return std::numeric_limits<std::int32_t>::max();
+    }
+    std::int32_t day = 0;
+    std::int32_t month = 0;
+    std::int32_t year = 0;
+    for (std::size_t i = 0; i < date.length(); ++i) {
+        if (i == 2 || i == 5) {
+            continue;
+        }
+        if (!std::isdigit(static_cast<unsigned char>(date[i]))) {
+            return std::numeric_limits<std::int32_t>::max();
+        }
+        const std::int32_t digit = date[i] - '0';
+        if (i < 2) {
+            day = day * 10 + digit;
+        } else if (i < 5) {
+            month = month * 10 + digit;
+        } else {
+            year = year * 10 + digit;
+        }
+    }
+    return year * 10000 + month * 100 + day;
+}
+
+void sortQueueByQuantityThenCost(Queue& queue, SortingDirection sortingDirection) {
+    ILONA_TIME_OPERATION(MetricOperation::Sort);
+    if (isEmpty(queue) || queue.head->next == nullptr) {
+        return;
+    }
+
+    // Переставляємо вузли, а не копіюємо записи: вказівники на вузли в індексах лишаються дійсними.
+    std::vector<WasteNode*> nodes;
+    nodes.reserve(queue.size);
+    for (WasteNode* current = queue.head; current != nullptr; current = current->next) {
+        nodes.push_back(current);
+    }
+
+    std::sort(nodes.begin(), nodes.end(), [sortingDirection](const WasteNode* leftNode, const WasteNode* rightNode) {
+        const WasteRecord& left = leftNode->data;
+        const WasteRecord& right = rightNode->data;
+        if (left.quantity != right.quantity) {
+            if (sortingDirection == SortingDirection::ASC) {
+                return left.quantity < right.quantity;
+            }
+
+            return left.quantity > right.quantity;
+        }
+
+        if (sortingDirection == SortingDirection::ASC) {
+            return left.cost < right.cost;
+        }
+
+        return left.cost > right.cost;
+    });
+
+    for (std::size_t i = 0; i + 1 < nodes.size(); ++i) {
+        nodes[i]->next = nodes[i + 1];
+        nodes[i + 1]->prev = nodes[i];
+    }
+    nodes.front()->prev = nullptr;
+    nodes.back()->next = nullptr;
+    queue.head = nodes.front();
+    queue.tail = nodes.back();
+
+    for (QueueListener* listener : queue.listeners) {
+        listener->onQueueReordered();
+    }
+}
+
+namespace {
+
+const std::size_t COMPRESSED_BLOCK_TARGET_SIZE = 256 * 1024;
+
+void writeRecord(std::ostream& out, const WasteRecord& rec) {
+    out << rec.companyCode << '\n';
+    out << rec.companyName << '\n';
+    out << rec.address << '\n';
+    out << rec.phone << '\n';
+    out << rec.wasteCode << '\n';
+    out << rec.wasteName << '\n';
+    out << static_cast<int>(rec.state) << '\n';
+    out << rec.removalDate << '\n';
+    out << rec.quantity << '\n';
+    out << std::fixed << std::setprecision(2) << rec.cost << '\n';
+    out << RECORD_SEPARATOR << '\n';
+    ILONA_COUNT(MetricCounter::RecordsSaved, 1);
+}
+
+} // namespace
+
+bool saveQueueToFile(const Queue& queue, const std::string& filename) {
+    ILONA_TIME_OPERATION(MetricOperation::SaveFile);
+    std::ofstream outFile(filename);
+    if (!outFile.is_open()) {
+        std::cerr << "Помилка: не вдалося відкрити файл для запису: " << filename << std::endl;
+        return false;
+    }
+
+    const WasteNode* current = queue.head;
+    while (current != nullptr) {
+        writeRecord(outFile, current->data);
+        current = current->next;
+    }
+    outFile.close();
+    if (!outFile) {
+        std::cerr << "Помилка: не вдалося записати файл: " << filename << std::endl;
+        return false;
+    }
+    ILONA_COUNT(MetricCounter::BytesWritten, fileSizeOnDisk(filename));
+    return true;
+}
+
+bool saveQueueToCompressedFile(const Queue& queue, const std::string& filename) {
+    ILONA_TIME_OPERATION(MetricOperation::SaveFile);
+    BlockFileWriter writer(filename);
+    if (!writer.isOpen()) {
+        std::cerr << "Помилка: не вдалося відкрити файл для запису: " << filename << std::endl;
+        return false;
+    }
+
+    // Записи не розриваються між блоками, тому кожен блок розбирається окремо.
+    std::ostringstream block;
+    std::uint32_t blockRecords = 0;
+    const WasteNode* current = queue.head;
+    while (current != nullptr) {
+        writeRecord(block, current->data);
+        ++blockRecords;
+        if (static_cast<std::size_t>(block.tellp()) >= COMPRESSED_BLOCK_TARGET_SIZE) {
+            writer.addBlock(block.str(), blockRecords);
+            block.str("");
+            blockRecords = 0;
+        }
+        current = current->next;
+    }
+    if (blockRecords > 0) {
+        writer.addBlock(block.str(), blockRecords);
+    }
+    if (!writer.finish()) {
+        std::cerr << "Помилка: не вдалося записати файл: " << filename << std::endl;
+        return false;
+    }
+    ILONA_COUNT(MetricCounter::BytesWritten, fileSizeOnDisk(filename));
+    return true;
+}
+
+namespace {
+
+// Розбирає записи текстового формату і передає кожен коректний запис в onRecord.
+template <typename OnRecord>
+void parseRecordStream(std::istream& inFile, OnRecord&& onRecord) {
+    std::string line;
+    // Тимчасові змінні для збору полів
+    std::string companyCode, companyName, address, phone, wasteCode, wasteName, removalDateStr;
+    int stateInt = 0, quantity = 0;
+    double cost = 0.0;
+    PhysicalState state = PhysicalState::Solid; // За замовчуванням
+
+    int fieldCounter = 0;
+    int recordLineNumber = 0; // Для повідомлень про помилки
+
+    while (std::getline(inFile, line)) {
+        recordLineNumber++;
+        if (line == RECORD_SEPARATOR) {
+            if (fieldCounter == 10) {
+                if (!isValidDate(removalDateStr)) {
+                    std::cerr << "Попередження (рядок " << recordLineNumber - 10 << "): Некоректна дата '" << removalDateStr << "' у записі для '" << companyName << "'. Запис пропущено.\n";
+                    ILONA_COUNT(MetricCounter::ParseErrorsSkipped, 1);
+                } else if (!isValidPhysicalState(stateInt)) {
+                     std::cerr << "Попередження (рядок " << recordLineNumber - 10 << "): Некоректний агрегатний стан '" << stateInt << "' у записі для '" << companyName << "'. Запис пропущено.\n";
+                    ILONA_COUNT(MetricCounter::ParseErrorsSkipped, 1);
+                } else {
+                    onRecord(WasteRecord(companyCode, companyName, address, phone, wasteCode, wasteName,
+                                         state, removalDateStr, quantity, cost));
+                    ILONA_COUNT(MetricCounter::RecordsLoaded, 1);
+                }
+            } else {
+                std::cerr << "Попередження (починаючи з рядка " << recordLineNumber - fieldCounter << "): Неповний запис у файлі перед '" << RECORD_SEPARATOR << "'. Пропущено.\n";
+                ILONA_COUNT(MetricCounter::ParseErrorsSkipped, 1);
+            }
+            // Скидання змінних для наступного запису
+            fieldCounter = 0;
+            companyCode.clear(); companyName.clear(); address.clear(); phone.clear();
+            wasteCode.clear(); wasteName.clear(); removalDateStr.clear();
+            stateInt = 0; quantity = 0; cost = 0.0; state = PhysicalState::Solid;
+            continue;
+        }
+
+        try {
+            switch (fieldCounter) {
+                case 0: companyCode = line; break;
+                case 1: companyName = line; break;
+                case 2: address = line; break;
+                case 3: phone = line; break;
+                case 4: wasteCode = line; break;
+                case 5: wasteName = line; break;
+                case 6: {
+                    stateInt = std::stoi(line);
+                    if (isValidPhysicalState(stateInt)) {
+                        state = static_cast<PhysicalState>(stateInt);
+                    } else {
+                         std::cerr << "Попередження (рядок " << recordLineNumber << "): Некоректне значення агрегатного стану '" << line << "'. Встановлено стандартне Solid.\n";
+                         state = PhysicalState::Solid;
+                    }
+                    break;
+                }
+                case 7: removalDateStr = line; break;
+                case 8: quantity = std::stoi(line); break;
+                case 9: cost = std::stod(line); break;
+                default:
+                    std::cerr << "Попередження (рядок " << recordLineNumber << "): Зайве поле у файлі: " << line << ". Пропущено.\n";
+                    break;
+            }
+            fieldCounter++;
+        } catch (const std::invalid_argument& ex) {
+            std::cerr << "Помилка парсингу (рядок " << recordLineNumber << ", поле " << fieldCounter << ", значення '" << line << "'): " << ex.what() << ". Запис буде пропущено.\n";
+            ILONA_COUNT(MetricCounter::ParseErrorsSkipped, 1);
+            while(std::getline(inFile, line) && line != RECORD_SEPARATOR) {recordLineNumber++;} // Пропустити до кінця поточного запису
+            fieldCounter = 0;
+            companyCode.clear(); companyName.clear(); address.clear(); phone.clear();
+            wasteCode.clear(); wasteName.clear(); removalDateStr.clear();
+            stateInt = 0; quantity = 0; cost = 0.0; state = PhysicalState::Solid;
+        } catch (const std::out_of_range& ex) {
+            std::cerr << "Помилка діапазону (рядок " << recordLineNumber << ", поле " << fieldCounter << ", значення '" << line << "'): " << ex.what() << ". Запис буде пропущено.\n";
+            ILONA_COUNT(MetricCounter::ParseErrorsSkipped, 1);
+            while(std::getline(inFile, line) && line != RECORD_SEPARATOR) {recordLineNumber++;}
+            fieldCounter = 0;
+            companyCode.clear(); companyName.clear(); address.clear(); phone.clear();
+            wasteCode.clear(); wasteName.clear(); removalDateStr.clear();
+            stateInt = 0; quantity = 0; cost = 0.0; state = PhysicalState::Solid;
+        }
+    }
+
+    if (fieldCounter > 0 && fieldCounter < 10) {
+        std::cerr << "Попередження: Файл закінчився на неповному записі (починаючи з рядка " << recordLineNumber - fieldCounter +1 << "). Останній неповний запис пропущено.\n";
+        ILONA_COUNT(MetricCounter::ParseErrorsSkipped, 1);
+    }
+}
+
+// Розпаковує і розбирає всі блоки паралельно; записи згруповано за блоками у порядку файлу.
+std::vector<std::vector<WasteRecord>> readCompressedBlocks(const std::string& filename) {
+    BlockFileReader reader(filename);
+    std::vector<std::vector<WasteRecord>> blocks(reader.blockCount());
+    reader.decodeAllBlocks([&blocks, &reader](const std::size_t blockIndex, const std::string& raw) {
+        std::vector<WasteRecord>& records = blocks[blockIndex];
+        records.reserve(reader.blockInfo(blockIndex).recordCount);
+        std::istringstream blockStream(raw);
+        parseRecordStream(blockStream, [&records](WasteRecord&& record) {
+            records.push_back(std::move(record));
+        });
+    });
+    return blocks;
+}
+
+bool loadQueueFromCompressedFile(Queue& queue, const std::string& filename) {
+    try {
+        std::vector<std::vector<WasteRecord>> blocks = readCompressedBlocks(filename);
+        clearQueue(queue);
+        for (std::vector<WasteRecord>& records : blocks) {
+            for (WasteRecord& record : records) {
+                enqueue(queue, std::move(record));
+            }
+            std::vector<WasteRecord>().swap(records);
+        }
+    } catch (const std::runtime_error& ex) {
+        std::cerr << "Помилка: не вдалося завантажити стиснутий файл " << filename << ": " << ex.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool loadQueueFromFile(Queue& queue, const std::string& filename) {
+    ILONA_TIME_OPERATION(MetricOperation::LoadFile);
+    ILONA_COUNT(MetricCounter::BytesRead, fileSizeOnDisk(filename));
+    if (isBlockContainerFile(filename)) {
+        return loadQueueFromCompressedFile(queue, filename);
+    }
+
+    std::ifstream inFile(filename);
+    if (!inFile.is_open()) {
+        std::cerr << "Попередження: не вдалося відкрити файл для читання: " << filename << std::endl;
+        return false;
+    }
+
+    clearQueue(queue);
+    parseRecordStream(inFile, [&queue](WasteRecord&& record) {
+        enqueue(queue, std::move(record));
+    });
+    inFile.close();
+    return true;
+}
+
+bool readRecordsFromFile(const std::string& filename, const std::function<void(WasteRecord&&)>& onRecord) {
+    ILONA_COUNT(MetricCounter::BytesRead, fileSizeOnDisk(filename));
+    if (isBlockContainerFile(filename)) {
+        // Блоки розпаковуються по одному, тож у пам'яті не більше одного блоку файлу.
+        try {
+            BlockFileReader reader(filename);
+            for (std::size_t blockIndex = 0; blockIndex < reader.blockCount(); ++blockIndex) {
+                std::istringstream blockStream(reader.readBlock(blockIndex));
+                parseRecordStream(blockStream, onRecord);
+            }
+        } catch (const std::runtime_error& ex) {
+            std::cerr << "Помилка: не вдалося прочитати стиснутий файл " << filename << ": " << ex.what() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    std::ifstream inFile(filename);
+    if (!inFile.is_open()) {
+        std::cerr << "Попередження: не вдалося відкрити файл для читання: " << filename << std::endl;
+        return false;
+    }
+    parseRecordStream(inFile, onRecord);
+    return true;
+}
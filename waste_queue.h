@@ -0,0 +1,135 @@
+#ifndef ILONA_WASTE_QUEUE_H
+#define ILONA_WASTE_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+enum class SortingDirection {
+    ASC = 1,
+    DESC = 2
+};
+
+enum class PhysicalState {
+    Solid = 1,
+    Liquid = 2,
+    Gas = 3
+};
+
+struct WasteRecord {
+    std::string companyCode;
+    std::string companyName;
+    std::string address;
+    std::string phone;
+    std::string wasteCode;
+    std::string wasteName;
+    PhysicalState state;
+    std::string removalDate;
+    int quantity;
+    double cost;
+
+    WasteRecord(
+        std::string  companyCode,
+        std::string  companyName,
+        std::string  address,
+        std::string  phone,
+        std::string  wasteCode,
+        std::string  wasteName,
+        PhysicalState state,
+        std::string  removalDate,
+        int quantity,
+        double cost
+    ) :
+        companyCode(std::move(companyCode)),
+        companyName(std::move(companyName)),
+        address(std::move(address)),
+        phone(std::move(phone)),
+        wasteCode(std::move(wasteCode)),
+        wasteName(std::move(wasteName)),
+        state(state),
+        removalDate(std::move(removalDate)),
+        quantity(quantity),
+        cost(cost) {}
+};
+
+// Зв'язок у обидва боки дозволяє вилучати вузол із середини черги за O(1) (removeNode).
+struct WasteNode {
+    WasteRecord data;
+    WasteNode* next;
+    WasteNode* prev;
+    explicit WasteNode(WasteRecord record) : data(std::move(record)), next(nullptr), prev(nullptr) {}
+};
+
+// Спостерігач змін черги для похідних структур (індекси пошуку, кеші звітів).
+// onRecordAdded - після додавання вузла, onRecordRemoved - перед його видаленням,
+// onRecordUpdated - після заміни даних вузла, onQueueCleared - перед очищенням,
+// onQueueReordered - після зміни порядку вузлів (записи й вузли лишаються ті самі).
+class QueueListener {
+public:
+    virtual ~QueueListener() = default;
+    virtual void onRecordAdded(const WasteNode& node) = 0;
+    virtual void onRecordRemoved(const WasteNode& node) = 0;
+    virtual void onRecordUpdated(const WasteNode& node, const WasteRecord& previous) = 0;
+    virtual void onQueueCleared() = 0;
+    virtual void onQueueReordered() {}
+};
+
+struct Queue {
+    WasteNode* head;
+    WasteNode* tail;
+    std::size_t size;
+    std::vector<QueueListener*> listeners;
+    explicit Queue() : head(nullptr), tail(nullptr), size(0) {}
+};
+
+bool isValidPhysicalState(int stateInt);
+std::string getPhysicalStateString(PhysicalState state);
+
+bool isEmpty(const Queue& queue);
+void clearQueue(Queue& queue);
+WasteRecord peek(const Queue& queue);
+void enqueue(Queue& queue, WasteRecord&& record);
+void enqueue(Queue& queue, const WasteRecord& record);
+WasteRecord dequeue(Queue& queue);
+// Вилучає довільний вузол черги (не лише перший) і повертає його дані.
+WasteRecord removeNode(Queue& queue, WasteNode* node);
+// Замінює дані вузла і повідомляє спостерігачів; вузол має належати черзі.
+void replaceRecord(Queue& queue, WasteNode& node, WasteRecord&& record);
+
+void addQueueListener(Queue& queue, QueueListener* listener);
+void removeQueueListener(Queue& queue, QueueListener* listener);
+
+// Межі числових полів, спільні для вводу з консолі, масових операцій і запитів сервера.
+constexpr int MIN_QUANTITY = 1;
+constexpr double MIN_COST = 0.01;
+
+// У файлі даних текстове поле займає один рядок: воно не може містити переведення
+// рядка або збігатися з рядком-роздільником записів.
+bool isValidTextField(const std::string& value);
+// Опис першого порушення правил запису або nullptr, якщо запис коректний.
+const char* recordValidationError(const WasteRecord& record);
+
+bool isLeapYear(int year);
+bool isValidDate(std::string_view date);
+std::string convertDateToComparableFormat(const std::string& date_ddmmyyyy);
+// Дата ДД:ММ:РРРР як число РРРРММДД для швидкого порівняння без виділення пам'яті;
+// для рядка не в цьому форматі повертає INT32_MAX (такі дати впорядковуються останніми).
+std::int32_t dateSortKey(std::string_view date);
+
+void sortQueueByQuantityThenCost(Queue& queue, SortingDirection sortingDirection);
+
+// Функції роботи з файлами повертають false, якщо операцію не виконано;
+// причину повідомляють у std::cerr. При невдалому завантаженні черга не змінюється.
+bool saveQueueToFile(const Queue& queue, const std::string& filename);
+bool saveQueueToCompressedFile(const Queue& queue, const std::string& filename);
+// Визначає формат файлу (текстовий чи блочний стиснутий) автоматично.
+bool loadQueueFromFile(Queue& queue, const std::string& filename);
+// Передає коректні записи файлу будь-якого з форматів в onRecord по одному, у порядку файлу,
+// не тримаючи в пам'яті весь файл і не змінюючи жодної черги.
+bool readRecordsFromFile(const std::string& filename, const std::function<void(WasteRecord&&)>& onRecord);
+
+#endif